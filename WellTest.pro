@@ -27,13 +27,22 @@ win32: LIBS += -lm
 
 # Input
 HEADERS += dataeditorwidget.h \
+           besselkernels.h \
            chartsetting1.h \
            chartsetting2.h \
+           compositeshalemodel.h \
            datacalculate.h \
            datecolumndialog.h \
+           differentialevolution.h \
            fittingobserveddata.h \
            fittingpage.h \
            fittingparameterchart.h \
+           fracturegeometry.h \
+           fracturekernel.h \
+           laplaceinversion.h \
+           laplacesamplecache.h \
+           levenbergmarquardt.h \
+           multistartsearch.h \
            modelmanager.h \
            modelparameter.h \
            modelselect.h \
@@ -55,6 +64,7 @@ HEADERS += dataeditorwidget.h \
            pressurederivativecalculator1.h \
            settingswidget.h \
            qcustomplot.h \
+           toeplitzsolver.h \
            wt_fittingwidget.h \
            wt_plottingwidget.h \
            wt_projectwidget.h
@@ -84,14 +94,23 @@ FORMS += dataeditorwidget.ui \
          wt_projectwidget.ui
 
 SOURCES += \
+           besselkernels.cpp \
            chartsetting1.cpp \
            chartsetting2.cpp \
+           compositeshalemodel.cpp \
            datacalculate.cpp \
            dataeditorwidget.cpp \
            datecolumndialog.cpp \
+           differentialevolution.cpp \
            fittingobserveddata.cpp \
            fittingpage.cpp \
            fittingparameterchart.cpp \
+           fracturegeometry.cpp \
+           fracturekernel.cpp \
+           laplaceinversion.cpp \
+           laplacesamplecache.cpp \
+           levenbergmarquardt.cpp \
+           multistartsearch.cpp \
            modelmanager.cpp \
            modelparameter.cpp \
            modelselect.cpp \
@@ -114,6 +133,7 @@ SOURCES += \
            pressurederivativecalculator1.cpp \
            settingswidget.cpp \
            qcustomplot.cpp \
+           toeplitzsolver.cpp \
            wt_fittingwidget.cpp \
            wt_plottingwidget.cpp \
            wt_projectwidget.cpp
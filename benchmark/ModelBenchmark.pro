@@ -0,0 +1,45 @@
+######################################################################
+# 模型计算引擎微基准 (控制台程序，不依赖界面)
+# 构建: qmake ModelBenchmark.pro && make (Windows 下 nmake / mingw32-make)
+# 运行: ModelBenchmark [重复次数]
+######################################################################
+# gui 仅供 PressureDerivativeCalculator (QStandardItemModel)，不创建任何窗口
+QT = core gui concurrent
+
+TEMPLATE = app
+TARGET = ModelBenchmark
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+# 与 WellTest.pro 相同的优化选项，计时才有可比性
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+unix: LIBS += -lm
+win32: LIBS += -lm
+
+INCLUDEPATH += ..
+INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
+INCLUDEPATH += D:/08YYYXXX/boost_1_89_0
+
+HEADERS += ../besselkernels.h \
+           ../compositeshalemodel.h \
+           ../fracturegeometry.h \
+           ../fracturekernel.h \
+           ../laplaceinversion.h \
+           ../laplacesamplecache.h \
+           ../pressurederivativecalculator.h \
+           ../toeplitzsolver.h
+
+SOURCES += modelbenchmark.cpp \
+           ../besselkernels.cpp \
+           ../compositeshalemodel.cpp \
+           ../fracturegeometry.cpp \
+           ../fracturekernel.cpp \
+           ../laplaceinversion.cpp \
+           ../laplacesamplecache.cpp \
+           ../pressurederivativecalculator.cpp \
+           ../toeplitzsolver.cpp
+
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
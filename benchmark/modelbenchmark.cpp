@@ -0,0 +1,99 @@
+/*
+ * modelbenchmark.cpp
+ * 文件作用：模型计算引擎微基准 (控制台程序)
+ * 功能描述：
+ * 1. 反演循环 (calculatePDandDeriv) 的单样本开销：Model 3、N = 8、100 个时间点、串行、PWD 缓存已预热，
+ *    每个样本只剩缓存查找与井储包装，拉普拉斯函数的调用分派开销在此最为明显
+ * 2. 拉普拉斯空间解 (flaplace_composite) 的单次开销：六种模型、不使用缓存、4000 个实数 z
+ * 每项重复若干次，输出最小值与中位数 (相邻两次运行之间的波动约 20%，比较前后版本时应看多次运行)
+ */
+
+#include "compositeshalemodel.h"
+
+#include <QMap>
+#include <QVector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+namespace {
+
+// 与界面默认参数同量级的一组参数 (4 条均匀裂缝)
+QMap<QString, double> benchmarkParameters()
+{
+    QMap<QString, double> p;
+    p.insert("phi", 0.05); p.insert("h", 20); p.insert("mu", 0.5); p.insert("B", 1.05); p.insert("Ct", 5e-4);
+    p.insert("q", 5); p.insert("nf", 4); p.insert("kf", 1e-3); p.insert("km", 1e-4);
+    p.insert("L", 1000); p.insert("Lf", 100); p.insert("LfD", 0.1); p.insert("rmD", 4); p.insert("reD", 10);
+    p.insert("omega1", 0.4); p.insert("omega2", 0.08); p.insert("lambda1", 1e-3); p.insert("gamaD", 0.02);
+    p.insert("cD", 0.01); p.insert("S", 1); p.insert("N", 8);
+    return p;
+}
+
+double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printStatistics(const char* label, QVector<double> samples, double scale, const char* unit)
+{
+    std::sort(samples.begin(), samples.end());
+    std::printf("%-28s min %8.1f %s   median %8.1f %s\n", label,
+                samples.first() * scale, unit, samples[samples.size() / 2] * scale, unit);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int repeats = argc > 1 ? std::max(1, std::atoi(argv[1])) : 9;
+    const CompositeModelParameters params = CompositeModelParameters::fromMap(benchmarkParameters());
+    double sink = 0.0; // 累加结果，防止求值被优化掉
+
+    // 1. 反演循环：每条曲线 100 点 × 8 个 Stehfest 节点
+    {
+        CompositeShaleModel model(CompositeShaleModel::Model_3);
+        const QVector<double> time = CompositeShaleModel::generateLogTimeSteps(100, -3.0, 3.0);
+        ModelEvaluationConfig config;
+        config.highPrecision = true;
+        config.parallel = false;
+        config.useLaplaceCache = true;
+
+        const int curves = 20;
+        const double samplesPerRun = double(curves) * time.size() * 8;
+        model.calculateTheoreticalCurve(params, time, config); // 预热 PWD 缓存
+
+        QVector<double> perSample;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            for (int c = 0; c < curves; ++c) sink += std::get<1>(model.calculateTheoreticalCurve(params, time, config)).last();
+            perSample.append(elapsedSeconds(start) / samplesPerRun);
+        }
+        printStatistics("calculatePDandDeriv (warm)", perSample, 1e9, "ns/sample");
+    }
+
+    // 2. 拉普拉斯空间解：z 在 [1e-2, 1e6] 上对数均匀取 4000 个
+    {
+        const int count = 4000;
+        QVector<double> z(count);
+        for (int i = 0; i < count; ++i) z[i] = std::pow(10.0, -2.0 + 8.0 * i / (count - 1));
+
+        for (int type = CompositeShaleModel::Model_1; type <= CompositeShaleModel::Model_6; ++type) {
+            CompositeShaleModel model((CompositeShaleModel::ModelType)type);
+            QVector<double> perCall;
+            for (int r = 0; r < repeats; ++r) {
+                auto start = std::chrono::steady_clock::now();
+                for (double s : z) sink += model.flaplace_composite(s, params, false);
+                perCall.append(elapsedSeconds(start) / count);
+            }
+            char label[64];
+            std::snprintf(label, sizeof(label), "flaplace_composite Model %d", type + 1);
+            printStatistics(label, perCall, 1e6, "us/call");
+        }
+    }
+
+    std::printf("(checksum %.6g)\n", sink);
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*
+ * compositeshalemodel.h
+ * 文件作用：压裂水平井复合页岩油模型计算引擎头文件
+ * 功能描述：
+ * 1. 从 ModelWidget01_06 中拆分出的无界面计算内核，不依赖任何 QWidget
+ * 2. 每个 ModelType 对应一个引擎实例，构造后不可变
+ * 3. 所有计算接口均为 const 且可重入，反演精度通过参数传入而非成员状态，
+ *    可在拟合、敏感性分析、批量计算等任务中多线程并发调用
+ */
+
+#ifndef COMPOSITESHALEMODEL_H
+#define COMPOSITESHALEMODEL_H
+
+#include <QMap>
+#include <QVector>
+#include <QString>
+#include <tuple>
+#include <complex>
+#include <memory>
+#include "laplacesamplecache.h"
+#include "laplaceinversion.h"
+#include "fracturegeometry.h"
+
+// 类型定义: <时间, 压力, 导数>
+using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
+
+// 理论曲线计算配置 (按值传入计算引擎，引擎本身不保存任何可变状态)
+struct ModelEvaluationConfig {
+    bool highPrecision;   // 是否使用高精度 Stehfest 反演 (对应 MATLAB 中的 N=8)
+    bool parallel;        // 是否将 (时间点 × 反演节点) 的拉普拉斯求值分发到全局线程池
+    bool useLaplaceCache; // 是否复用已缓存的 PWD_composite 结果 (不含井储/表皮)
+
+    LaplaceInversion::Method inversion; // 拉普拉斯反演方法
+    int talbotNodes;                    // Talbot 节点数 M (双精度下 16~32)
+    int deHoogTerms;                    // de Hoog 阶数 M (节点数 2M+1)
+    double deHoogTolerance;             // de Hoog 离散化误差目标 (决定围道横坐标 γ)
+    int eulerTerms;                     // Euler 求和阶数 M (节点数 2M+1，双精度下 11~19)
+    int extendedStehfestN;              // 扩展精度 Stehfest 项数 (偶数，最大 24，不受 highPrecision 与参数 N 影响)
+    double sampleMergeTolerance;        // 样本池合并节点的相对距离 (0 表示只合并完全相同的 z，结果不变)
+
+    bool adaptiveTimeGrid;              // 在自适应对数网格上求解后单调三次插值到请求时间 (适用于高频实测数据)
+    double adaptiveTolerance;           // 自适应网格的插值误差目标 (ln PD 的绝对误差，约等于相对误差)
+    int adaptivePointsPerDecade;        // 自适应初始网格每个对数周期的点数
+
+    bool analyticDerivative;            // 允许导数由 t·L^-1{s·F(s)} 与 PD 共用样本直接反演 (仅在反演精度足够时生效，见 usesAnalyticDerivative)；
+                                        // 为 false 或精度不足时对 PD 做 Bourdet 差分 (L = 0.1)
+
+    ModelEvaluationConfig() :
+        highPrecision(true),
+        parallel(true),
+        useLaplaceCache(true),
+        inversion(LaplaceInversion::Stehfest),
+        talbotNodes(20),
+        deHoogTerms(16),
+        deHoogTolerance(1e-12),
+        eulerTerms(15),
+        extendedStehfestN(18),
+        sampleMergeTolerance(0.0),
+        adaptiveTimeGrid(false),
+        adaptiveTolerance(1e-4),
+        adaptivePointsPerDecade(8),
+        analyticDerivative(true) {}
+
+    // 实际是否使用解析导数: s·F(s) 的反演比 F(s) 更依赖反演精度，低阶 Stehfest (N < 12，含拟合用的 N = 4)
+    // 在井储峰后的凹谷处误差可达 27%，不如 Bourdet 差分；Talbot、de Hoog、Euler 与 N >= 12 的 Stehfest 才使用
+    bool usesAnalyticDerivative(int stehfestN) const
+    {
+        if (!analyticDerivative) return false;
+        switch (inversion) {
+        case LaplaceInversion::Stehfest: return stehfestN >= 12;
+        case LaplaceInversion::StehfestExtended: return extendedStehfestN >= 12;
+        default: return true;
+        }
+    }
+};
+
+// 模型参数 (由 QMap<QString, double> 在接口处一次性转换，计算内核中按字段直接访问，
+// 避免拉普拉斯求值时逐次按字符串查表；结构体可按值廉价复制，用于拟合时的参数扰动)
+struct CompositeModelParameters {
+    // 量纲换算参数
+    double phi;     // 孔隙度
+    double mu;      // 粘度 (mPa·s)
+    double B;       // 体积系数
+    double Ct;      // 综合压缩系数 (1/MPa)
+    double q;       // 产量 (m³/d)
+    double h;       // 有效厚度 (m)
+    double kf;      // 内区渗透率 (mD)
+    double km;      // 外区渗透率 (mD)
+    double L;       // 水平井长度 (m)
+    double Lf;      // 裂缝半长 (m)，仅用于由 Lf/L 更新 LfD
+
+    // 无因次参数
+    double LfD;     // 无因次裂缝半长
+    double rmD;     // 复合半径
+    double reD;     // 外边界半径 (0 表示未设置)
+    double omega1;  // 内区储容比
+    double omega2;  // 外区储容比
+    double lambda1; // 窜流系数
+    double cD;      // 井筒储存系数
+    double S;       // 表皮系数
+    double gamaD;   // 压敏系数
+    int nf;         // 裂缝条数 (>= 1)
+    int N;          // Stehfest 项数 (参数表中的 "N")
+
+    // 非均匀裂缝布局 (只能通过结构体给出，参数表中没有对应项；两者均为空时为等间距等长布局)
+    QVector<double> fracturePositions;   // 各裂缝中心位置 xwD (为空时按 nf 在 [-0.9, 0.9] 等间距分布；非空时裂缝条数以此为准)
+    QVector<double> fractureHalfLengths; // 各裂缝无因次半长 (条数须与位置一致，否则均取 LfD)
+
+    bool hasLengthPair; // 参数表同时给出 L 与 Lf，修改二者之一时同步换算 LfD
+
+    CompositeModelParameters() :
+        phi(0.05), mu(0.5), B(1.05), Ct(5e-4), q(5.0), h(20.0), kf(1e-3), km(0.0), L(1000.0), Lf(0.0),
+        LfD(0.0), rmD(0.0), reD(0.0), omega1(0.0), omega2(0.0), lambda1(0.0), cD(0.0), S(0.0), gamaD(0.0),
+        nf(4), N(4), hasLengthPair(false) {}
+
+    // 由参数表转换，缺省项取上面的默认值
+    static CompositeModelParameters fromMap(const QMap<QString, double>& p);
+
+    // 按参数名修改单个字段 (L / Lf 会同步更新 LfD)，模型不使用的参数名返回 false
+    bool setValue(const QString& name, double value);
+};
+
+// 分段恒定产量历史 (变产量/压力恢复试井)
+// 第 i 段从 startTimes[i] (h，升序，与曲线时间同一时间轴) 开始，产量为 rates[i] (m³/d，关井段为 0)
+struct RateHistory {
+    QVector<double> startTimes;
+    QVector<double> rates;
+
+    // 由"时长-产量"表构造 (与 PlottingStackWidget 阶梯图的输入相同，第一段从 t = 0 开始)
+    static RateHistory fromDurations(const QVector<double>& durations, const QVector<double>& rates);
+
+    // 是否包含产量变化 (只有一段或为空时等价于恒定产量)
+    bool isMultiRate() const { return rates.size() > 1; }
+};
+
+class CompositeShaleModel
+{
+public:
+    typedef std::complex<double> Complex;
+
+    enum ModelType {
+        Model_1 = 0, // 无限大 + 变井储
+        Model_2,     // 无限大 + 恒定井储
+        Model_3,     // 封闭边界 + 变井储
+        Model_4,     // 封闭边界 + 恒定井储
+        Model_5,     // 定压边界 + 变井储
+        Model_6      // 定压边界 + 恒定井储
+    };
+
+    explicit CompositeShaleModel(ModelType type);
+
+    ModelType type() const { return m_type; }
+
+    // 获取模型名称
+    QString getModelName() const;
+    static QString getModelName(ModelType type);
+
+    // 模型特征判断
+    static bool hasWellboreStorage(ModelType type); // 变井储模型 (1, 3, 5)
+    static bool isInfiniteBoundary(ModelType type); // 无限大边界 (1, 2)
+
+    // 生成对数时间步长
+    static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
+
+    // 计算理论曲线 (线程安全)
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params,
+                                             const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelEvaluationConfig& config = ModelEvaluationConfig()) const;
+    ModelCurveData calculateTheoreticalCurve(const CompositeModelParameters& params,
+                                             const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelEvaluationConfig& config = ModelEvaluationConfig()) const;
+    // 写入调用方提供的缓冲区 (时间轴即 time，为空时输出为空)。缓冲区容量足够且未被共享时不重新分配，
+    // 拟合循环中反复求值同一组时间点时可复用同一对缓冲区
+    void calculateTheoreticalCurve(const CompositeModelParameters& params, const QVector<double>& time,
+                                   const ModelEvaluationConfig& config,
+                                   QVector<double>& outPressure, QVector<double>& outDerivative) const;
+
+    // 变产量叠加曲线 (线程安全): Δp(t) = Σ (q_i - q_(i-1))·p_u(t - t_i)，p_u 为单位产量响应。
+    // 全部台阶的经过时间 t - t_i 合并后在同一自适应对数网格上求解一次 (不随台阶数线性增长)，
+    // 叠加在 PD 上进行 (以 params.q 为参考产量)，再统一做压敏修正与量纲换算。
+    // 导数为对当前产量段经过时间的对数导数 dΔp/dlnΔt (Δt 为距最近一次产量变化的时间，首段即 t)，
+    // 不使用解析导数时 (见 ModelEvaluationConfig::usesAnalyticDerivative) 在每个产量段内对 Δt 做 Bourdet 差分
+    ModelCurveData calculateSuperposedCurve(const CompositeModelParameters& params, const RateHistory& history,
+                                            const QVector<double>& time,
+                                            const ModelEvaluationConfig& config = ModelEvaluationConfig()) const;
+    void calculateSuperposedCurve(const CompositeModelParameters& params, const RateHistory& history,
+                                  const QVector<double>& time, const ModelEvaluationConfig& config,
+                                  QVector<double>& outPressure, QVector<double>& outDerivative) const;
+
+    // 拉普拉斯空间解 (复合模型通用入口)
+    // useCache: 是否通过 PWD 缓存求解裂缝部分 (结果与直接计算逐位一致)
+    double flaplace_composite(double z, const QMap<QString, double>& p, bool useCache = true) const;
+    double flaplace_composite(double z, const CompositeModelParameters& p, bool useCache = true) const;
+    // 复数 z 版本 (Talbot / de Hoog / Euler 反演节点)，要求 z 不在负实轴上
+    Complex flaplace_composite(const Complex& z, const QMap<QString, double>& p, bool useCache = true) const;
+    Complex flaplace_composite(const Complex& z, const CompositeModelParameters& p, bool useCache = true) const;
+
+    // 清空 PWD 缓存
+    void clearLaplaceCache() const;
+
+private:
+    // 数学计算核心 (拉普拉斯反演循环)
+    // 先求出全部 (时间点 × 反演节点) 的拉普拉斯样本 (重合节点只求一次，可并行)，再按固定顺序串行合成，
+    // 因此并行与串行结果逐位一致。实数节点方法调用 laplaceFunc，复数节点方法调用 complexLaplaceFunc
+    // (任意可调用对象，按模板参数传入以便编译器内联，不经过 std::function)
+    // time 为有因次时间，无因次化在反演时逐点完成；压敏修正与量纲换算在最后一次遍历中原地完成，
+    // outPressure / outDerivative 即最终曲线
+    template <typename LaplaceFunc, typename ComplexLaplaceFunc>
+    void calculatePDandDeriv(const QVector<double>& time, const CompositeModelParameters& params,
+                             const LaplaceFunc& laplaceFunc, const ComplexLaplaceFunc& complexLaplaceFunc,
+                             const ModelEvaluationConfig& config,
+                             QVector<double>& outPressure, QVector<double>& outDerivative) const;
+
+    // 变产量叠加的实现 (单位响应由 calculatePDAdaptive 在共享网格上求出)
+    template <typename LaplaceFunc, typename ComplexLaplaceFunc>
+    void calculateSuperposition(const QVector<double>& time, const RateHistory& history, const CompositeModelParameters& params,
+                                const LaplaceFunc& laplaceFunc, const ComplexLaplaceFunc& complexLaplaceFunc,
+                                const ModelEvaluationConfig& config,
+                                QVector<double>& outPressure, QVector<double>& outDerivative) const;
+
+    // 按模型类型构造实数/复数节点的拉普拉斯求值函数 (裂缝几何每次调用构造一次)，以 body(func, complexFunc) 调用
+    template <typename Body>
+    void withLaplaceFunctions(const CompositeModelParameters& params, bool useCache, Body&& body) const;
+
+    // 逐点求 PD (样本池 + 反演合成)，tD = timeScale·time；outDeriv 非空时同时由同一批样本反演解析导数 t·dPD/dt
+    template <typename LaplaceFunc, typename ComplexLaplaceFunc>
+    void calculatePD(const QVector<double>& time, double timeScale, const CompositeModelParameters& params,
+                     const LaplaceFunc& laplaceFunc, const ComplexLaplaceFunc& complexLaplaceFunc,
+                     const ModelEvaluationConfig& config,
+                     QVector<double>& outPD, QVector<double>* outDeriv) const;
+
+    // 自适应求 PD (及解析导数): 先在粗对数网格上计算，逐轮在插值误差超出 adaptiveTolerance 且包含请求点的区间中点加密，
+    // 最后在双对数空间单调三次插值到请求的时间点；请求点不多于初始网格时退化为逐点计算
+    template <typename LaplaceFunc, typename ComplexLaplaceFunc>
+    void calculatePDAdaptive(const QVector<double>& time, double timeScale, const CompositeModelParameters& params,
+                             const LaplaceFunc& laplaceFunc, const ComplexLaplaceFunc& complexLaplaceFunc,
+                             const ModelEvaluationConfig& config,
+                             QVector<double>& outPD, QVector<double>* outDeriv) const;
+
+    // 自适应网格的最大加密轮数 (最细间距为初始间距的 1/2^MaxAdaptiveLevels)
+    static const int MaxAdaptiveLevels = 12;
+
+    // 按配置与参数 N 确定 Stehfest 项数 (低精度时为 4)
+    static int stehfestTerms(const ModelEvaluationConfig& config, const CompositeModelParameters& params);
+    // 按配置创建反演方法 (stehfestN 为已确定的 Stehfest 项数)
+    static std::unique_ptr<LaplaceInversionMethod> createInversion(const ModelEvaluationConfig& config, int stehfestN);
+
+    // 拉普拉斯空间解的实现，T 为 double 或 Complex
+    // Boundary (无限大/封闭/定压) 与 Storage (是否考虑井储表皮) 为编译期策略，
+    // 六种模型各自实例化，按 m_type 的分派在每条曲线 (或每次公开接口调用) 中只进行一次
+    // geometry 由 p.nf、p.LfD 或非均匀布局数组构造，每条曲线只构造一次，在全部 z 之间共享
+    template <typename Boundary, typename Storage, typename T>
+    T evaluateLaplace(const T& z, const CompositeModelParameters& p, const FractureGeometry& geometry, bool useCache) const;
+
+    // PWD 核心计算 (包含边界条件处理 Logic from MATLAB PWD_inf)，T 为 double 或 Complex
+    // 裂缝位置、间距与积分区间取自预先构造的 geometry；等间距等长布局用 Levinson 递推，任意布局用稠密 LU
+    template <typename Boundary, typename T>
+    T PWD_composite(const T& z, const T& fs1, const T& fs2, double M12, double rmD, double reD, const FractureGeometry& geometry) const;
+
+    // PWD_composite 中使用栈上缓冲区的最大裂缝条数
+    static const int MaxStackFractures = 128;
+
+private:
+    ModelType m_type;
+
+    // PWD_composite 结果缓存 (内部加锁，不影响 const 接口的可重入性)
+    mutable LaplaceSampleCache m_pwdCache;
+};
+
+#endif // COMPOSITESHALEMODEL_H
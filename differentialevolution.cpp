@@ -0,0 +1,151 @@
+/*
+ * differentialevolution.cpp
+ * 文件作用：差分进化全局优化器实现
+ * 功能描述：
+ * 1. jDE 自适应: 以概率 τ 为个体重新抽取 F ∈ [0.1, 1.0]、CR ∈ [0, 1]，试验个体胜出时连同其 F / CR 一起保留
+ * 2. 随机数只在主线程按个体顺序抽取，并发仅用于求值，相同种子得到相同的搜索路径
+ * 3. 求值失败 (空残差、长度不一致或含非有限值) 的个体误差记为 +inf，不会进入种群
+ */
+
+#include "differentialevolution.h"
+
+#include <QtConcurrent>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <algorithm>
+
+DifferentialEvolution::DifferentialEvolution(const DifferentialEvolutionConfig& config)
+    : m_config(config)
+{
+}
+
+void DifferentialEvolution::setBounds(const QVector<double>& lower, const QVector<double>& upper)
+{
+    m_lower = lower;
+    m_upper = upper;
+}
+
+FitStatistics DifferentialEvolution::minimize(const LevenbergMarquardtSolver::ResidualFunction& residuals, QVector<double>& x) const
+{
+    FitStatistics stats;
+    const int n = x.size();
+    const double inf = std::numeric_limits<double>::infinity();
+    const int populationSize = std::max(4, m_config.populationSize > 0 ? m_config.populationSize : std::max(15, 10 * n));
+
+    // 边界与采样范围 (某侧无界时以初始值为中心)
+    QVector<double> lower(n, -inf), upper(n, inf), sampleLow(n), sampleHigh(n);
+    for (int j = 0; j < n; ++j) {
+        if (j < m_lower.size() && !std::isnan(m_lower[j])) lower[j] = m_lower[j];
+        if (j < m_upper.size() && !std::isnan(m_upper[j])) upper[j] = m_upper[j];
+        x[j] = std::min(std::max(x[j], lower[j]), upper[j]);
+        sampleLow[j] = std::isfinite(lower[j]) ? lower[j] : std::min(x[j], upper[j]) - m_config.unboundedSpan;
+        sampleHigh[j] = std::isfinite(upper[j]) ? upper[j] : std::max(x[j], lower[j]) + m_config.unboundedSpan;
+    }
+
+    // 整批并发求值均方误差，种群已占满线程池，单条曲线内部不再并行
+    int m = 0;
+    auto evaluateAll = [&](const QVector<QVector<double>>& points, QVector<double>& costs) {
+        costs.fill(inf, points.size());
+        QVector<int> order(points.size());
+        std::iota(order.begin(), order.end(), 0);
+        QtConcurrent::blockingMap(order, [&](int k) {
+            QVector<double> r = residuals(points[k], true);
+            if (r.isEmpty() || (m > 0 && r.size() != m)) return;
+            double sum = 0.0;
+            for (double v : r) sum += v * v;
+            if (std::isfinite(sum)) costs[k] = sum / r.size();
+        });
+        stats.residualEvaluations += points.size();
+    };
+
+    // 初始种群: 第一个个体为 x，其余在采样范围内均匀分布
+    std::mt19937 rng(m_config.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    QVector<QVector<double>> population(populationSize, x);
+    for (int k = 1; k < populationSize; ++k)
+        for (int j = 0; j < n; ++j) population[k][j] = sampleLow[j] + unit(rng) * (sampleHigh[j] - sampleLow[j]);
+
+    // 先单独求值初始点以确定残差长度，其余个体整批求值
+    QVector<double> r0 = residuals(x, false);
+    stats.residualEvaluations++;
+    double cost0 = 0.0;
+    for (double v : r0) cost0 += v * v;
+    if (r0.isEmpty() || !std::isfinite(cost0)) {
+        stats.termination = FitTermination::EvaluationFailed;
+        return stats;
+    }
+    m = r0.size();
+    QVector<double> costs;
+    evaluateAll(population.mid(1), costs);
+    costs.prepend(cost0 / m);
+    stats.initialError = costs[0];
+
+    QVector<double> F(populationSize, m_config.initialF), CR(populationSize, m_config.initialCR);
+    auto bestIndex = [&]() { return int(std::min_element(costs.begin(), costs.end()) - costs.begin()); };
+    int best = bestIndex();
+    stats.finalError = costs[best];
+    if (m_generationCallback) m_generationCallback(0, population[best], costs[best]);
+
+    QVector<QVector<double>> trials(populationSize, x);
+    QVector<double> trialF(populationSize), trialCR(populationSize), trialCosts;
+    stats.termination = FitTermination::MaxIterations;
+    while (true) {
+        if (m_config.targetMeanSquare > 0.0 && costs[best] <= m_config.targetMeanSquare) {
+            stats.termination = FitTermination::TargetReached;
+            break;
+        }
+        double worst = *std::max_element(costs.begin(), costs.end());
+        if (std::isfinite(worst) && worst - costs[best] <= m_config.costTolerance * costs[best]) {
+            stats.termination = FitTermination::CostTolerance;
+            break;
+        }
+        if (m_stopCallback && m_stopCallback()) { stats.termination = FitTermination::Stopped; break; }
+        if (stats.iterations >= m_config.maxGenerations) { stats.termination = FitTermination::MaxIterations; break; }
+        if (m_config.maxEvaluations > 0 && stats.residualEvaluations >= m_config.maxEvaluations) {
+            stats.termination = FitTermination::MaxEvaluations;
+            break;
+        }
+
+        // 生成试验个体 DE/rand/1/bin: v = a + F·(b - c)，越界分量取父代与边界的中点
+        std::uniform_int_distribution<int> pick(0, populationSize - 1);
+        std::uniform_int_distribution<int> pickDimension(0, std::max(0, n - 1));
+        for (int k = 0; k < populationSize; ++k) {
+            trialF[k] = (unit(rng) < m_config.adaptProbability) ? 0.1 + 0.9 * unit(rng) : F[k];
+            trialCR[k] = (unit(rng) < m_config.adaptProbability) ? unit(rng) : CR[k];
+            int a, b, c;
+            do { a = pick(rng); } while (a == k);
+            do { b = pick(rng); } while (b == k || b == a);
+            do { c = pick(rng); } while (c == k || c == a || c == b);
+            int forced = pickDimension(rng);
+            const QVector<double>& parent = population[k];
+            QVector<double>& trial = trials[k];
+            for (int j = 0; j < n; ++j) {
+                if (j != forced && unit(rng) >= trialCR[k]) { trial[j] = parent[j]; continue; }
+                double v = population[a][j] + trialF[k] * (population[b][j] - population[c][j]);
+                if (v < lower[j]) v = 0.5 * (parent[j] + lower[j]);
+                else if (v > upper[j]) v = 0.5 * (parent[j] + upper[j]);
+                trial[j] = v;
+            }
+        }
+
+        evaluateAll(trials, trialCosts);
+        stats.iterations++;
+        for (int k = 0; k < populationSize; ++k) {
+            if (trialCosts[k] > costs[k]) continue;
+            population[k] = trials[k];
+            costs[k] = trialCosts[k];
+            F[k] = trialF[k];
+            CR[k] = trialCR[k];
+            stats.acceptedSteps++;
+        }
+        best = bestIndex();
+        stats.finalError = costs[best];
+        stats.errorHistory.append(costs[best]);
+        if (m_generationCallback) m_generationCallback(stats.iterations, population[best], costs[best]);
+    }
+
+    x = population[best];
+    return stats;
+}
@@ -0,0 +1,68 @@
+/*
+ * differentialevolution.h
+ * 文件作用：差分进化 (Differential Evolution) 全局优化器头文件
+ * 功能描述：
+ * 1. 与界面无关，与 LevenbergMarquardtSolver 共用残差回调与求解变量空间，目标函数为均方误差 rᵀr/m
+ * 2. 变异策略 DE/rand/1/bin，缩放因子 F 与交叉率 CR 按个体自适应 (jDE)，无需针对问题调参
+ * 3. 边界原生处理: 初始种群在上下界内均匀采样，越界的试验分量取父代与边界的中点
+ * 4. 每一代的试验个体整批分发到全局线程池并发求值，单条曲线内部不再并行
+ */
+
+#ifndef DIFFERENTIALEVOLUTION_H
+#define DIFFERENTIALEVOLUTION_H
+
+#include "levenbergmarquardt.h"
+
+// 差分进化配置
+struct DifferentialEvolutionConfig {
+    int populationSize;       // 种群规模 (0 表示取 max(15, 10·n))
+    int maxGenerations;       // 最大代数
+    int maxEvaluations;       // 残差求值次数上限 (0 表示不限)
+    double initialF;          // 初始缩放因子
+    double initialCR;         // 初始交叉率
+    double adaptProbability;  // 每代各个体重新抽取 F / CR 的概率 (jDE 中的 τ)
+    double costTolerance;     // 种群误差的离散度 (max - min) <= tol·min 时认为已收敛
+    double targetMeanSquare;  // 最优均方误差达到该值即停止 (0 表示不启用)
+    double unboundedSpan;     // 某侧无界的变量在初始值两侧各取该跨度作为采样范围
+    unsigned int seed;        // 随机数种子
+
+    DifferentialEvolutionConfig() :
+        populationSize(0),
+        maxGenerations(200),
+        maxEvaluations(0),
+        initialF(0.5),
+        initialCR(0.9),
+        adaptProbability(0.1),
+        costTolerance(1e-3),
+        targetMeanSquare(0.0),
+        unboundedSpan(1.0),
+        seed(20241227u)
+    {}
+};
+
+class DifferentialEvolution
+{
+public:
+    // 每一代结束后回调: 代数、当前最优点与其均方误差 (第 0 代为初始种群)
+    typedef std::function<void(int generation, const QVector<double>& x, double meanSquare)> GenerationCallback;
+
+    explicit DifferentialEvolution(const DifferentialEvolutionConfig& config = DifferentialEvolutionConfig());
+
+    // 参数上下界 (含义与 LevenbergMarquardtSolver 相同)
+    void setBounds(const QVector<double>& lower, const QVector<double>& upper);
+    void setGenerationCallback(const GenerationCallback& callback) { m_generationCallback = callback; }
+    void setStopCallback(const LevenbergMarquardtSolver::StopCallback& callback) { m_stopCallback = callback; }
+
+    // x 为初始点 (作为种群的第一个个体)，返回时为最优点。
+    // 统计中 iterations 为代数，acceptedSteps 为替换父代的次数，errorHistory 为每代的最优误差
+    FitStatistics minimize(const LevenbergMarquardtSolver::ResidualFunction& residuals, QVector<double>& x) const;
+
+private:
+    DifferentialEvolutionConfig m_config;
+    QVector<double> m_lower;
+    QVector<double> m_upper;
+    GenerationCallback m_generationCallback;
+    LevenbergMarquardtSolver::StopCallback m_stopCallback;
+};
+
+#endif // DIFFERENTIALEVOLUTION_H
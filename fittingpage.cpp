@@ -43,6 +43,12 @@ void FittingPage::setObservedDataToCurrent(const QVector<double> &t, const QVect
     }
 }
 
+void FittingPage::setRateHistoryToCurrent(const QVector<double> &durations, const QVector<double> &rates)
+{
+    FittingWidget* current = qobject_cast<FittingWidget*>(ui->tabWidget->currentWidget());
+    if (current) current->setRateHistory(RateHistory::fromDurations(durations, rates));
+}
+
 void FittingPage::updateBasicParameters()
 {
     for(int i = 0; i < ui->tabWidget->count(); ++i) {
@@ -27,6 +27,9 @@ public:
     // 接收来自 MainWindow 的数据，传递给当前激活的 FittingWidget
     void setObservedDataToCurrent(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d);
 
+    // 接收图表页的时长-产量表，构造产量历史后传递给当前激活的 FittingWidget (为空时按恒定产量)
+    void setRateHistoryToCurrent(const QVector<double>& durations, const QVector<double>& rates);
+
     // 初始化/重置基本参数
     void updateBasicParameters();
 
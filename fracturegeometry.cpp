@@ -0,0 +1,108 @@
+/*
+ * fracturegeometry.cpp
+ * 文件作用：裂缝几何预计算实现
+ * 功能描述：
+ * 1. 生成等间距裂缝位置与各间距
+ * 2. 任意布局时把 nf×nf 个矩阵元素按 (间距, 源裂缝半长) 排序去重，记录每个元素所属的组合
+ * 3. 按观测点是否落在源裂缝内部，把积分区间 [d-L, d+L] 拆分为 [0, L+d] 与 [0, L-d]，或保持 [d-L, d+L]
+ * 4. 任意布局时收集全部区间端点排序去重，记录各区间两端的端点下标
+ */
+
+#include "fracturegeometry.h"
+
+#include <cmath>
+#include <algorithm>
+
+FractureGeometry::FractureGeometry(int nf, double halfLength)
+    : m_toeplitz(true)
+{
+    if (nf < 1) nf = 1;
+    m_positions.resize(nf);
+    if (nf == 1) { m_positions[0] = 0.0; } else {
+        double start = -0.9; double end = 0.9; double step = (end - start) / (nf - 1);
+        for (int i = 0; i < nf; ++i) m_positions[i] = start + i * step;
+    }
+    m_halfLengths.fill(halfLength, nf);
+
+    m_offsets.reserve(nf);
+    m_offsetHalfLengths.reserve(nf);
+    m_segments.reserve(2 * nf);
+    m_segmentBegin.reserve(nf + 1);
+    for (int k = 0; k < nf; ++k) appendOffset(std::abs(m_positions[k] - m_positions[0]), halfLength);
+    m_segmentBegin.append(m_segments.size());
+}
+
+FractureGeometry::FractureGeometry(const QVector<double>& positions, const QVector<double>& halfLengths)
+    : m_positions(positions)
+    , m_halfLengths(halfLengths)
+    , m_toeplitz(false)
+{
+    const int nf = m_positions.size();
+    m_halfLengths.resize(nf);
+
+    // 全部 (i, j) 元素按 (间距, 源裂缝半长) 排序后去重
+    struct Pair {
+        double d;
+        double L;
+        int index; // i * nf + j
+    };
+    QVector<Pair> pairs;
+    pairs.reserve(nf * nf);
+    for (int i = 0; i < nf; ++i) {
+        for (int j = 0; j < nf; ++j) {
+            Pair p = { std::abs(m_positions[i] - m_positions[j]), m_halfLengths[j], i * nf + j };
+            pairs.append(p);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) {
+        if (a.d != b.d) return a.d < b.d;
+        if (a.L != b.L) return a.L < b.L;
+        return a.index < b.index;
+    });
+
+    m_offsetIndex.resize(nf * nf);
+    m_segmentBegin.reserve(nf * nf + 1);
+    m_segments.reserve(2 * nf * nf);
+    for (int n = 0; n < pairs.size(); ++n) {
+        const Pair& p = pairs[n];
+        if (n == 0 || p.d != m_offsets.last() || p.L != m_offsetHalfLengths.last()) appendOffset(p.d, p.L);
+        m_offsetIndex[p.index] = m_offsets.size() - 1;
+    }
+    m_segmentBegin.append(m_segments.size());
+
+    // 区间端点排序去重，各区间两端按二分查找得到下标
+    m_breakpoints.reserve(2 * m_segments.size());
+    for (const Segment& s : m_segments) {
+        m_breakpoints.append(s.u0);
+        m_breakpoints.append(s.u1);
+    }
+    std::sort(m_breakpoints.begin(), m_breakpoints.end());
+    m_breakpoints.erase(std::unique(m_breakpoints.begin(), m_breakpoints.end()), m_breakpoints.end());
+    m_segmentPoints.reserve(2 * m_segments.size());
+    for (const Segment& s : m_segments) {
+        m_segmentPoints.append(int(std::lower_bound(m_breakpoints.begin(), m_breakpoints.end(), s.u0) - m_breakpoints.begin()));
+        m_segmentPoints.append(int(std::lower_bound(m_breakpoints.begin(), m_breakpoints.end(), s.u1) - m_breakpoints.begin()));
+    }
+
+    m_layout = m_positions + m_halfLengths;
+}
+
+void FractureGeometry::appendOffset(double d, double L)
+{
+    m_offsets.append(d);
+    m_offsetHalfLengths.append(L);
+    m_segmentBegin.append(m_segments.size());
+    if (!(L > 0.0)) return;
+    if (d < L) {
+        // 区间跨过奇点 u = 0，按 |u| 折叠为两段从 0 开始的积分
+        Segment a = { 0.0, L + d };
+        m_segments.append(a);
+        if (L - d > 0.0) {
+            Segment b = { 0.0, L - d };
+            m_segments.append(b);
+        }
+    } else {
+        Segment a = { d - L, d + L };
+        m_segments.append(a);
+    }
+}
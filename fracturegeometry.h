@@ -0,0 +1,86 @@
+/*
+ * fracturegeometry.h
+ * 文件作用：裂缝几何预计算头文件
+ * 功能描述：
+ * 1. 每组参数构造一次，与拉普拉斯变量 z 无关，在一条曲线的全部 z 求值之间共享
+ * 2. 保存裂缝位置 xwD、各裂缝半长、互不相同的 (间距, 源裂缝半长) 组合，
+ *    以及影响矩阵元素 (i, j) 到该组合下标的对应关系
+ * 3. 每个组合的线源积分区间 ∫_{d-L}^{d+L} g(|u|) du 预先在 K0 奇点 u = 0 处拆分为
+ *    u 空间中的非负区间，拉普拉斯求值时积分器只需把区间端点乘以 γ1
+ * 4. 求积节点不在此预计算: 积分器在 t = γ1·u 空间中布置 (奇点附近级数闭式、远处按衰减截断)，
+ *    随 z 跨越多个数量级时仍保持精度
+ * 5. 两种布局: 等间距等长 (影响矩阵为对称 Toeplitz 阵，组合数为 nf) 与任意位置/半长
+ *    (一般稠密阵，组合数不超过 nf^2，相同间距与半长的元素仍共用一个积分)
+ * 6. 任意布局另存全部区间端点 (升序去重) 及各区间两端在其中的下标: 积分器在这些端点上求一次原函数，
+ *    每个区间的积分只是两个原函数值之差
+ */
+
+#ifndef FRACTUREGEOMETRY_H
+#define FRACTUREGEOMETRY_H
+
+#include <QVector>
+
+class FractureGeometry
+{
+public:
+    // u 空间中的积分区间 (0 <= u0 < u1)
+    struct Segment {
+        double u0;
+        double u1;
+    };
+
+    // 等间距裂缝: nf 条裂缝均布于 [-0.9, 0.9] (nf = 1 时位于 0)，半长均为 halfLength
+    FractureGeometry(int nf, double halfLength);
+
+    // 任意布局: positions[i] 为第 i 条裂缝中心的 xwD，halfLengths[i] 为其无因次半长 (两者长度相同)
+    FractureGeometry(const QVector<double>& positions, const QVector<double>& halfLengths);
+
+    int fractureCount() const { return m_positions.size(); }
+    const QVector<double>& positions() const { return m_positions; }
+    double halfLength(int j) const { return m_halfLengths[j]; }
+
+    // 影响矩阵是否为对称 Toeplitz 阵 (等间距等长布局)，此时组合 k 即 |i - j| = k
+    bool isToeplitz() const { return m_toeplitz; }
+
+    // 互不相同的 (间距, 源裂缝半长) 组合个数，第 k 个组合的间距与半长
+    int offsetCount() const { return m_offsets.size(); }
+    double offset(int k) const { return m_offsets[k]; }
+    double offsetHalfLength(int k) const { return m_offsetHalfLengths[k]; }
+
+    // 矩阵元素 (i, j) (观测裂缝 i、源裂缝 j) 对应的组合下标
+    int offsetIndex(int i, int j) const
+    {
+        if (m_toeplitz) return i > j ? i - j : j - i;
+        return m_offsetIndex[i * m_positions.size() + j];
+    }
+
+    // 组合 k 的积分区间 (1 段或跨过奇点时 2 段，半长为 0 时没有)
+    int segmentCount(int k) const { return m_segmentBegin[k + 1] - m_segmentBegin[k]; }
+    const Segment& segment(int k, int s) const { return m_segments[m_segmentBegin[k] + s]; }
+
+    // 任意布局: 全部区间端点 (升序去重，等间距布局为空)，组合 k 第 s 段的下端点与上端点在其中的下标
+    const QVector<double>& breakpoints() const { return m_breakpoints; }
+    int segmentLower(int k, int s) const { return m_segmentPoints[2 * (m_segmentBegin[k] + s)]; }
+    int segmentUpper(int k, int s) const { return m_segmentPoints[2 * (m_segmentBegin[k] + s) + 1]; }
+
+    // 布局数组 (等间距布局为空，任意布局为各位置后接各半长)，作为拉普拉斯样本缓存键的一部分逐项比较
+    const QVector<double>& layout() const { return m_layout; }
+
+private:
+    // 追加一个组合及其积分区间
+    void appendOffset(double d, double L);
+
+    QVector<double> m_positions;
+    QVector<double> m_halfLengths;
+    bool m_toeplitz;
+    QVector<double> m_offsets;
+    QVector<double> m_offsetHalfLengths;
+    QVector<int> m_offsetIndex;  // 任意布局时为 nf×nf 行主序表
+    QVector<Segment> m_segments;
+    QVector<int> m_segmentBegin; // 组合 k 的区间为 m_segments[m_segmentBegin[k] .. m_segmentBegin[k+1])
+    QVector<double> m_breakpoints;
+    QVector<int> m_segmentPoints; // 第 n 个区间两端的端点下标为 [2n], [2n+1]
+    QVector<double> m_layout;
+};
+
+#endif // FRACTUREGEOMETRY_H
@@ -0,0 +1,455 @@
+/*
+ * fracturekernel.cpp
+ * 文件作用：裂缝影响函数积分器实现
+ * 功能描述：
+ * 1. 积分变量替换 u = d - a，把 I(d) 化为 g(|u|) 在 [d-L, d+L] 上的积分，
+ *    区间跨过 0 时在奇点处拆分为两段从 0 开始的积分 (拆分由 FractureGeometry 预先完成)
+ * 2. ∫_0^T K0(t)dt 由 K0 的幂级数逐项积分得到 (T <= 2)，其余部分用分段 Gauss-Legendre
+ * 3. Ac·I0 项光滑，只在其量级不可忽略的区间上积分
+ * 4. 求积节点成批交给 BesselKernels 计算缩放 Bessel 函数，指数因子按段中心提出
+ * 5. 复数版本在 u 空间积分: |γ1|·u <= 2 用同一级数闭式 (解析延拓到复数)，
+ *    其余部分用几何加密分段，段宽在 |t| 空间不超过 min(到原点距离, 6)
+ * 6. 原函数: 级数区内逐点用闭式；级数区外按等宽分段 (|t| 空间宽度不超过 2)，每段由 16 个节点值
+ *    求出 Legendre 展开系数，段内任意点的部分积分按 ∫_{-1}^s P_n = (P_{n+1}(s) - P_{n-1}(s)) / (2n+1) 求和
+ */
+
+#include "fracturekernel.h"
+
+#include "besselkernels.h"
+
+#include <cmath>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+const double kSeriesLimit = 2.0;   // 级数展开适用的上限 (t <= 2 时收敛快且无抵消)
+const double kK0Cutoff = 60.0;     // K0(60) ~ 1e-27，之后的积分贡献可忽略
+const double kMaxPanelWidth = 2.0; // Gauss-Legendre 分段在 t 空间中的最大宽度
+const int kChunkPanels = 32;       // 每批送入 BesselKernels 的分段数 (32×16 个节点)
+const double kComplexMaxPanelWidth = 6.0; // 复数版本分段在 |t| 空间中的最大宽度
+const double kEulerGamma = 0.57721566490153286061;
+
+// 16 点 Gauss-Legendre 节点与权重 ([-1, 1] 区间)，首次使用时由 Newton 迭代求出
+struct GaussLegendre16 {
+    enum { N = 16 };
+    double x[N];
+    double w[N];
+    // 节点值到 Legendre 展开系数 c_n 的变换，已除以 2n+1 (n >= 1) 以便逐项积分: w_i·P_n(x_i) / 2
+    double legendre[N][N];
+    // Legendre 递推 P_{n+1} = recurrenceA[n]·s·P_n - recurrenceB[n]·P_{n-1}
+    double recurrenceA[N];
+    double recurrenceB[N];
+
+    GaussLegendre16() {
+        for (int i = 0; i < N; ++i) {
+            double z = std::cos(M_PI * (i + 0.75) / (N + 0.5));
+            double pp = 0.0;
+            for (int iter = 0; iter < 100; ++iter) {
+                double p1 = 1.0, p2 = 0.0;
+                for (int j = 0; j < N; ++j) {
+                    double p3 = p2; p2 = p1;
+                    p1 = ((2.0 * j + 1.0) * z * p2 - j * p3) / (j + 1);
+                }
+                pp = N * (z * p1 - p2) / (z * z - 1.0);
+                double z1 = z;
+                z = z1 - p1 / pp;
+                if (std::abs(z - z1) < 1e-16) break;
+            }
+            x[i] = z;
+            w[i] = 2.0 / ((1.0 - z * z) * pp * pp);
+        }
+        for (int n = 0; n < N; ++n) {
+            recurrenceA[n] = (2.0 * n + 1.0) / (n + 1);
+            recurrenceB[n] = (double)n / (n + 1);
+        }
+        for (int i = 0; i < N; ++i) {
+            double p0 = 1.0, p1 = x[i];
+            legendre[0][i] = 0.5 * w[i];
+            legendre[1][i] = 0.5 * w[i] * p1;
+            for (int n = 1; n + 1 < N; ++n) {
+                double p2 = recurrenceA[n] * x[i] * p1 - recurrenceB[n] * p0;
+                legendre[n + 1][i] = 0.5 * w[i] * p2;
+                p0 = p1; p1 = p2;
+            }
+        }
+    }
+};
+
+const GaussLegendre16& gaussLegendre16()
+{
+    static const GaussLegendre16 rule;
+    return rule;
+}
+
+// 节点值 f[i] 对应的 Legendre 展开系数 (n >= 1 时为 c_n / (2n+1))，展开式在 [-1, 1] 上的积分为 2·c[0]
+template <typename T>
+void legendreCoefficients(const T* f, T* c)
+{
+    const GaussLegendre16& gl = gaussLegendre16();
+    for (int n = 0; n < GaussLegendre16::N; ++n) {
+        T s = 0.0;
+        for (int i = 0; i < GaussLegendre16::N; ++i) s += gl.legendre[n][i] * f[i];
+        c[n] = s;
+    }
+}
+
+// 展开式在 [-1, s] 上的积分: c[0]·(s + 1) + Σ_{n>=1} c[n]·(P_{n+1}(s) - P_{n-1}(s))
+template <typename T>
+T legendrePartialIntegral(const T* c, double s)
+{
+    const GaussLegendre16& gl = gaussLegendre16();
+    double p0 = 1.0, p1 = s;
+    T sum = c[0] * (s + 1.0);
+    for (int n = 1; n < GaussLegendre16::N; ++n) {
+        double p2 = gl.recurrenceA[n] * s * p1 - gl.recurrenceB[n] * p0;
+        sum += c[n] * (p2 - p0);
+        p0 = p1; p1 = p2;
+    }
+    return sum;
+}
+
+} // namespace
+
+FractureKernelIntegrator::FractureKernelIntegrator(double gama1, double acPrefactor, double argG1Rm)
+    : m_gama1(gama1)
+    , m_acPrefactor(acPrefactor)
+    , m_argG1Rm(argG1Rm)
+{
+    // Ac·I0(t) ≈ Ac_prefactor·exp(t - γ1·rmD)，量级低于 e^-60 的部分不再积分
+    if (acPrefactor == 0.0 || !std::isfinite(acPrefactor)) m_acCutoff = HUGE_VAL;
+    else m_acCutoff = argG1Rm - 60.0 - std::log(std::abs(acPrefactor));
+}
+
+double FractureKernelIntegrator::integrateRange(double u0, double u1) const
+{
+    double g = m_gama1;
+    if (g <= 0.0 || u1 <= u0) return 0.0;
+
+    // 在 t = γ1·u 空间中积分
+    double t0 = g * u0;
+    double t1 = g * u1;
+    return (k0Integral(t0, t1) + acI0Integral(t0, t1)) / g;
+}
+
+double FractureKernelIntegrator::k0Integral(double t0, double t1) const
+{
+    if (t1 <= t0) return 0.0;
+    double s = 0.0;
+
+    // 奇点附近: 级数闭式
+    if (t0 < kSeriesLimit) {
+        double a = std::min(t1, kSeriesLimit);
+        s += k0IntegralSeries(a) - (t0 > 0.0 ? k0IntegralSeries(t0) : 0.0);
+    }
+
+    // 远离奇点: 分段 Gauss-Legendre
+    double a = std::max(t0, kSeriesLimit);
+    double b = std::min(t1, kK0Cutoff);
+    if (b > a) s += gaussPanels(a, b, false, 0.0);
+    return s;
+}
+
+double FractureKernelIntegrator::acI0Integral(double t0, double t1) const
+{
+    double a = std::max(t0, m_acCutoff);
+    double b = t1;
+    if (b <= a) return 0.0;
+    return m_acPrefactor * gaussPanels(a, b, true, m_argG1Rm);
+}
+
+double FractureKernelIntegrator::gaussPanels(double a, double b, bool isI0, double shift) const
+{
+    const GaussLegendre16& gl = gaussLegendre16();
+    const int N = GaussLegendre16::N;
+    int panels = (int)std::ceil((b - a) / kMaxPanelWidth);
+    double width = (b - a) / panels;
+    double h = 0.5 * width;
+
+    // 缩放函数 f 乘回指数因子: K0(t) = k0e(t)·e^-t，I0(t)·e^-shift = i0e(t)·e^(t-shift)
+    // 各段宽度相同，e^(±h·x_i) 只需计算一次，每段只剩段中心处的一次 exp
+    double sigma = isI0 ? 1.0 : -1.0;
+    double nodeFactor[N];
+    for (int i = 0; i < N; ++i) nodeFactor[i] = gl.w[i] * std::exp(sigma * h * gl.x[i]);
+
+    double t[kChunkPanels * N];
+    double f[kChunkPanels * N];
+    double s = 0.0;
+    for (int p0 = 0; p0 < panels; p0 += kChunkPanels) {
+        int np = std::min(kChunkPanels, panels - p0);
+        for (int p = 0; p < np; ++p) {
+            double c = a + (p0 + p + 0.5) * width;
+            for (int i = 0; i < N; ++i) t[p * N + i] = c + h * gl.x[i];
+        }
+
+        // 一次性计算本批全部求积节点上的缩放 Bessel 函数
+        if (isI0) BesselKernels::i0e(t, f, np * N);
+        else      BesselKernels::k0e(t, f, np * N);
+
+        for (int p = 0; p < np; ++p) {
+            double c = a + (p0 + p + 0.5) * width;
+            double exponent = sigma * (c - shift);
+            if (exponent < -700.0) continue;
+            double ps = 0.0;
+            for (int i = 0; i < N; ++i) ps += nodeFactor[i] * f[p * N + i];
+            s += ps * h * std::exp(exponent);
+        }
+    }
+    return s;
+}
+
+void FractureKernelIntegrator::antiderivative(const double* u, int count, double* G) const
+{
+    for (int i = 0; i < count; ++i) G[i] = 0.0;
+    double g = m_gama1;
+    if (g <= 0.0 || count == 0) return;
+    double tMax = g * u[count - 1];
+
+    // K0: 级数区内逐点闭式，级数区外在 S(2) 的基础上分段累加
+    for (int i = 0; i < count && g * u[i] <= kSeriesLimit; ++i) G[i] = k0IntegralSeries(g * u[i]);
+    if (tMax > kSeriesLimit) {
+        panelAntiderivative(kSeriesLimit, std::min(tMax, kK0Cutoff), false, 0.0,
+                            k0IntegralSeries(kSeriesLimit), 1.0, u, count, G);
+    }
+
+    // Ac·I0: 只在量级不可忽略的部分积分
+    double a = std::max(m_acCutoff, 0.0);
+    if (tMax > a) panelAntiderivative(a, tMax, true, m_argG1Rm, 0.0, m_acPrefactor, u, count, G);
+
+    for (int i = 0; i < count; ++i) G[i] /= g;
+}
+
+void FractureKernelIntegrator::panelAntiderivative(double a, double b, bool isI0, double shift, double base, double scale,
+                                                   const double* u, int count, double* G) const
+{
+    const GaussLegendre16& gl = gaussLegendre16();
+    const int N = GaussLegendre16::N;
+    const double g = m_gama1;
+    int panels = std::max(1, (int)std::ceil((b - a) / kMaxPanelWidth));
+    double width = (b - a) / panels;
+    double h = 0.5 * width;
+
+    // 与 gaussPanels 相同的指数因子拆分，展开的是 f(t)·e^(σ·(t - c)) (段内变化不超过 e)
+    double sigma = isI0 ? 1.0 : -1.0;
+    double nodeScale[N];
+    for (int i = 0; i < N; ++i) nodeScale[i] = std::exp(sigma * h * gl.x[i]);
+
+    int next = 0;
+    while (next < count && g * u[next] <= a) ++next;
+
+    double t[kChunkPanels * N];
+    double f[kChunkPanels * N];
+    double values[N];
+    double coeff[N];
+    double integral = base;
+    for (int p0 = 0; p0 < panels && next < count; p0 += kChunkPanels) {
+        int np = std::min(kChunkPanels, panels - p0);
+        for (int p = 0; p < np; ++p) {
+            double c = a + (p0 + p + 0.5) * width;
+            for (int i = 0; i < N; ++i) t[p * N + i] = c + h * gl.x[i];
+        }
+        if (isI0) BesselKernels::i0e(t, f, np * N);
+        else      BesselKernels::k0e(t, f, np * N);
+
+        for (int p = 0; p < np && next < count; ++p) {
+            double c = a + (p0 + p + 0.5) * width;
+            double right = (p0 + p + 1 == panels) ? b : c + h;
+            double exponent = sigma * (c - shift);
+            double factor = (exponent < -700.0) ? 0.0 : h * std::exp(exponent);
+            for (int i = 0; i < N; ++i) values[i] = factor * nodeScale[i] * f[p * N + i];
+            legendreCoefficients(values, coeff);
+            for (; next < count && g * u[next] <= right; ++next) {
+                G[next] += scale * (integral + legendrePartialIntegral(coeff, (g * u[next] - c) / h));
+            }
+            integral += 2.0 * coeff[0];
+        }
+    }
+    for (; next < count; ++next) G[next] += scale * integral;
+}
+
+double FractureKernelIntegrator::k0IntegralSeries(double T)
+{
+    // K0(t) = Σ c_k t^(2k) [H_k - γE - ln(t/2)],  c_k = 1 / (4^k (k!)^2)
+    // 逐项积分: ∫_0^T = Σ c_k T^(2k+1)/(2k+1) [H_k - γE - ln(T/2) + 1/(2k+1)]
+    if (T <= 0.0) return 0.0;
+    double logTerm = -kEulerGamma - std::log(0.5 * T);
+    double q = 0.25 * T * T;
+    double ck = 1.0;   // c_k T^(2k)
+    double Hk = 0.0;   // 调和数 H_k
+    double s = 0.0;
+    for (int k = 0; k < 60; ++k) {
+        if (k > 0) {
+            ck *= q / ((double)k * k);
+            Hk += 1.0 / k;
+        }
+        double m = 2.0 * k + 1.0;
+        double term = ck / m * (Hk + logTerm + 1.0 / m);
+        s += term;
+        if (k > 2 && std::abs(term) < 1e-17 * std::abs(s)) break;
+    }
+    return s * T;
+}
+
+// ---------------- 复数 γ1 版本 ----------------
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+// ∫_0^T K0(t) dt 的级数展开 (复数 T，|T| <= 2)
+Complex k0IntegralSeriesComplex(const Complex& T)
+{
+    if (T == 0.0) return 0.0;
+    Complex logTerm = -kEulerGamma - std::log(0.5 * T);
+    Complex q = 0.25 * T * T;
+    Complex ck = 1.0;
+    double Hk = 0.0;
+    Complex s = 0.0;
+    for (int k = 0; k < 60; ++k) {
+        if (k > 0) {
+            ck *= q / ((double)k * k);
+            Hk += 1.0 / k;
+        }
+        double m = 2.0 * k + 1.0;
+        Complex term = ck / m * (Hk + logTerm + 1.0 / m);
+        s += term;
+        if (k > 2 && std::abs(term) < 1e-17 * std::abs(s)) break;
+    }
+    return s * T;
+}
+
+} // namespace
+
+ComplexFractureKernelIntegrator::ComplexFractureKernelIntegrator(const Complex& gama1, const Complex& acPrefactor, const Complex& argG1Rm)
+    : m_gama1(gama1)
+    , m_acPrefactor(acPrefactor)
+    , m_argG1Rm(argG1Rm)
+{
+    m_absGama = std::abs(gama1);
+    double re = gama1.real();
+
+    // |K0(γ1·u)| ~ exp(-Re(γ1)·u)，指数低于 e^-60 的部分不再积分
+    m_k0Cutoff = (re > 0.0) ? 60.0 / re : HUGE_VAL;
+
+    // |Ac·I0(γ1·u)| ~ |Ac_prefactor|·exp(Re(γ1)·u - Re(γ1·rmD))
+    double absAc = std::abs(acPrefactor);
+    if (absAc == 0.0 || !std::isfinite(absAc) || re <= 0.0) m_acCutoff = (absAc == 0.0) ? HUGE_VAL : 0.0;
+    else m_acCutoff = (argG1Rm.real() - 60.0 - std::log(absAc)) / re;
+}
+
+ComplexFractureKernelIntegrator::Complex ComplexFractureKernelIntegrator::integrateRange(double u0, double u1) const
+{
+    if (m_absGama <= 0.0 || u1 <= u0) return 0.0;
+    return k0Integral(u0, u1) + acI0Integral(u0, u1);
+}
+
+ComplexFractureKernelIntegrator::Complex ComplexFractureKernelIntegrator::k0Integral(double u0, double u1) const
+{
+    if (u1 <= u0) return 0.0;
+    Complex s = 0.0;
+
+    // 奇点附近: 级数闭式，∫_0^U K0(γu) du = S(γU) / γ
+    double uSeries = kSeriesLimit / m_absGama;
+    if (u0 < uSeries) {
+        double a = std::min(u1, uSeries);
+        Complex sa = k0IntegralSeriesComplex(m_gama1 * a);
+        Complex s0 = (u0 > 0.0) ? k0IntegralSeriesComplex(m_gama1 * u0) : Complex(0.0);
+        s += (sa - s0) / m_gama1;
+    }
+
+    double a = std::max(u0, uSeries);
+    double b = std::min(u1, m_k0Cutoff);
+    if (b > a) s += gaussPanels(a, b, false);
+    return s;
+}
+
+ComplexFractureKernelIntegrator::Complex ComplexFractureKernelIntegrator::acI0Integral(double u0, double u1) const
+{
+    double a = std::max(u0, m_acCutoff);
+    double b = u1;
+    if (b <= a) return 0.0;
+    return m_acPrefactor * gaussPanels(a, b, true);
+}
+
+void ComplexFractureKernelIntegrator::antiderivative(const double* u, int count, Complex* G) const
+{
+    for (int i = 0; i < count; ++i) G[i] = 0.0;
+    if (m_absGama <= 0.0 || count == 0) return;
+    double uMax = u[count - 1];
+
+    // K0: 级数区内逐点闭式，∫_0^U K0(γu) du = S(γU) / γ
+    double uSeries = kSeriesLimit / m_absGama;
+    for (int i = 0; i < count && u[i] <= uSeries; ++i) G[i] = k0IntegralSeriesComplex(m_gama1 * u[i]) / m_gama1;
+    if (uMax > uSeries) {
+        panelAntiderivative(uSeries, std::min(uMax, m_k0Cutoff), false,
+                            k0IntegralSeriesComplex(m_gama1 * uSeries) / m_gama1, 1.0, u, count, G);
+    }
+
+    double a = std::max(m_acCutoff, 0.0);
+    if (uMax > a) panelAntiderivative(a, uMax, true, 0.0, m_acPrefactor, u, count, G);
+}
+
+void ComplexFractureKernelIntegrator::panelAntiderivative(double a, double b, bool isI0, const Complex& base, const Complex& scale,
+                                                          const double* u, int count, Complex* G) const
+{
+    const GaussLegendre16& gl = gaussLegendre16();
+    const int N = GaussLegendre16::N;
+
+    // 等宽分段，|t| 空间宽度不超过 kMaxPanelWidth；K0 部分从 uSeries 开始，段宽不超过到原点的距离
+    int panels = std::max(1, (int)std::ceil((b - a) * m_absGama / kMaxPanelWidth));
+    double width = (b - a) / panels;
+    double h = 0.5 * width;
+
+    int next = 0;
+    while (next < count && u[next] <= a) ++next;
+
+    Complex values[N];
+    Complex coeff[N];
+    Complex integral = base;
+    for (int p = 0; p < panels && next < count; ++p) {
+        double c = a + (p + 0.5) * width;
+        double right = (p + 1 == panels) ? b : c + h;
+        for (int i = 0; i < N; ++i) {
+            Complex t = m_gama1 * (c + h * gl.x[i]);
+            if (isI0) values[i] = h * BesselKernels::i0e(t) * std::exp(t - m_argG1Rm);
+            else      values[i] = h * BesselKernels::k0e(t) * std::exp(-t);
+        }
+        legendreCoefficients(values, coeff);
+        for (; next < count && u[next] <= right; ++next) {
+            G[next] += scale * (integral + legendrePartialIntegral(coeff, (u[next] - c) / h));
+        }
+        integral += 2.0 * coeff[0];
+    }
+    for (; next < count; ++next) G[next] += scale * integral;
+}
+
+ComplexFractureKernelIntegrator::Complex ComplexFractureKernelIntegrator::gaussPanels(double a, double b, bool isI0) const
+{
+    const GaussLegendre16& gl = gaussLegendre16();
+    const int N = GaussLegendre16::N;
+    const double maxWidth = kComplexMaxPanelWidth / m_absGama;
+
+    // 段宽不小于 maxWidth / 3，分段数不超过 (b - a)·|γ1| / 2 + 1，随 |z|·LfD 增长而不截断
+    Complex s = 0.0;
+    double left = a;
+    while (left < b) {
+        // 段宽不超过左端点到原点的距离 (K0 奇点)，也不超过 |t| 空间中的固定宽度
+        double width = std::min(std::max(left, maxWidth / 3.0), maxWidth);
+        double right = std::min(b, left + width);
+        double c = 0.5 * (left + right);
+        double h = 0.5 * (right - left);
+
+        Complex ps = 0.0;
+        for (int i = 0; i < N; ++i) {
+            Complex t = m_gama1 * (c + h * gl.x[i]);
+            if (isI0) ps += gl.w[i] * BesselKernels::i0e(t) * std::exp(t - m_argG1Rm);
+            else      ps += gl.w[i] * BesselKernels::k0e(t) * std::exp(-t);
+        }
+        s += ps * h;
+        left = right;
+    }
+    return s;
+}
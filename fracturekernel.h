@@ -0,0 +1,88 @@
+/*
+ * fracturekernel.h
+ * 文件作用：裂缝影响函数积分器头文件
+ * 功能描述：
+ * 1. 计算 PWD_composite 中 nf×nf 影响矩阵元素所需的线源积分
+ *        I(d) = ∫_{-LfD}^{LfD} [ K0(γ|d-a|) + Ac·I0(γ|d-a|) ] da
+ * 2. 积分核只依赖裂缝间距 d，且关于 d 对称：等间距裂缝只需计算 nf 个不同积分
+ * 3. K0 的对数奇点附近使用逐项积分的级数闭式，远离奇点使用固定 16 点 Gauss-Legendre，
+ *    无递归、无 std::function
+ * 4. ComplexFractureKernelIntegrator 为复数 γ1 (复数域拉普拉斯反演节点) 下的同一积分
+ * 5. 积分区间由 FractureGeometry 预先在奇点处拆分为 u 空间中的非负区间 [u0, u1]，
+ *    I(d) 为该间距各区间上 integrateRange 之和
+ * 6. 任意布局的区间数为 O(nf^2)，改用原函数 G(u) = ∫_0^u g 在全部区间端点上的值: 分段与求积节点
+ *    只取决于 γ1 与最大端点，各端点的部分积分由段内 Legendre 展开逐项积分得到，不再调用 Bessel 函数
+ */
+
+#ifndef FRACTUREKERNEL_H
+#define FRACTUREKERNEL_H
+
+#include <complex>
+
+class FractureKernelIntegrator
+{
+public:
+    // gama1: 内区 γ1；acPrefactor = Ac·exp(γ1·rmD)；argG1Rm = γ1·rmD
+    FractureKernelIntegrator(double gama1, double acPrefactor, double argG1Rm);
+
+    // ∫_{u0}^{u1} [K0(γ1·u) + Ac·I0(γ1·u)] du，0 <= u0 < u1
+    double integrateRange(double u0, double u1) const;
+
+    // 原函数 G(u) = ∫_0^u [K0(γ1·v) + Ac·I0(γ1·v)] dv 在升序点 u[0..count) 上的值 (u[0] >= 0)，写入 G
+    void antiderivative(const double* u, int count, double* G) const;
+
+private:
+    // ∫_{t0}^{t1} K0(t) dt (t = γu, 0 <= t0 < t1)
+    double k0Integral(double t0, double t1) const;
+    // ∫_{t0}^{t1} Ac_prefactor·I0(t)·exp(-γ1·rmD) dt
+    double acI0Integral(double t0, double t1) const;
+
+    // 分段 16 点 Gauss-Legendre: isI0 为 false 时求 ∫ K0(t) dt，为 true 时求 ∫ I0(t)·exp(-shift) dt
+    double gaussPanels(double a, double b, bool isI0, double shift) const;
+
+    // antiderivative 的分段部分: 在 t 空间 [a, b] 上逐段展开，t = γ1·u > a 的点累加 scale·(base + ∫_a^t)
+    void panelAntiderivative(double a, double b, bool isI0, double shift, double base, double scale,
+                             const double* u, int count, double* G) const;
+
+    // ∫_0^T K0(t) dt 的级数展开 (T <= SeriesLimit 时精确到机器精度)
+    static double k0IntegralSeries(double T);
+
+    double m_gama1;
+    double m_acPrefactor;
+    double m_argG1Rm;
+    double m_acCutoff; // t 小于该值时 Ac·I0 项可忽略
+};
+
+// 复数 γ1 版本: 积分在实变量 u 上进行，被积函数 K0(γ1·u)、I0(γ1·u) 使用复数 Bessel 函数
+class ComplexFractureKernelIntegrator
+{
+public:
+    typedef std::complex<double> Complex;
+
+    ComplexFractureKernelIntegrator(const Complex& gama1, const Complex& acPrefactor, const Complex& argG1Rm);
+
+    Complex integrateRange(double u0, double u1) const;
+
+    // 原函数 G(u) = ∫_0^u [K0(γ1·v) + Ac·I0(γ1·v)] dv 在升序点 u[0..count) 上的值 (u[0] >= 0)，写入 G
+    void antiderivative(const double* u, int count, Complex* G) const;
+
+private:
+    // ∫_{u0}^{u1} K0(γ1·u) du
+    Complex k0Integral(double u0, double u1) const;
+    // ∫_{u0}^{u1} Ac_prefactor·I0(γ1·u)·exp(-γ1·rmD) du
+    Complex acI0Integral(double u0, double u1) const;
+    // 几何加密的分段 Gauss-Legendre (分段宽度不超过到原点距离)
+    Complex gaussPanels(double a, double b, bool isI0) const;
+    // antiderivative 的分段部分: 在 u 空间 [a, b] 上逐段展开，u > a 的点累加 scale·(base + ∫_a^u)
+    void panelAntiderivative(double a, double b, bool isI0, const Complex& base, const Complex& scale,
+                             const double* u, int count, Complex* G) const;
+
+    Complex m_gama1;
+    Complex m_acPrefactor;
+    Complex m_argG1Rm;
+    double m_absGama;
+    double m_k0Cutoff; // u 大于该值时 K0 项可忽略
+    double m_acCutoff; // u 小于该值时 Ac·I0 项可忽略
+};
+
+#endif // FRACTUREKERNEL_H
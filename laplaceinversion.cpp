@@ -0,0 +1,321 @@
+/*
+ * laplaceinversion.cpp
+ * 文件作用：拉普拉斯数值反演工具实现
+ * 功能描述：
+ * 1. Stehfest 权重按 N 建表，避免在每个时间点、每一项上重复计算阶乘
+ * 2. 阶乘与乘积全部使用 long double，避免 double 阶乘乘积带来的舍入误差
+ * 3. Talbot / de Hoog / Euler 三种复数节点方法的节点生成与合成
+ * 4. 扩展精度 Stehfest 的权重表与高精度求和 (boost::multiprecision，仅头文件，与平台 long double 宽度无关)
+ * 5. de Hoog 的 QD 表与递推缓冲区按线程复用，逐点合成时不分配内存
+ */
+
+#include "laplaceinversion.h"
+
+#include <cmath>
+#include <algorithm>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+// 所有偶数 N 的权重表: table[N][i-1] = Vi
+struct StehfestTable {
+    double weights[LaplaceInversion::MaxStehfestN + 1][LaplaceInversion::MaxStehfestN];
+};
+
+long double factorialLD(int n)
+{
+    long double r = 1.0L;
+    for (int i = 2; i <= n; ++i) r *= i;
+    return r;
+}
+
+// 扩展精度: 权重计算用 50 位十进制 (24! 等阶乘可精确表示)，存储与求和用 113 位二进制 (四精度)
+typedef boost::multiprecision::cpp_bin_float_50 WeightFloat;
+typedef boost::multiprecision::cpp_bin_float_quad QuadFloat;
+
+WeightFloat factorialMP(int n)
+{
+    WeightFloat r = 1;
+    for (int i = 2; i <= n; ++i) r *= i;
+    return r;
+}
+
+WeightFloat extendedStehfestCoefficient(int i, int N)
+{
+    WeightFloat s = 0;
+    int k1 = (i + 1) / 2;
+    int k2 = std::min(i, N / 2);
+    for (int k = k1; k <= k2; ++k) {
+        WeightFloat num = boost::multiprecision::pow(WeightFloat(k), N / 2) * factorialMP(2 * k);
+        WeightFloat den = factorialMP(N / 2 - k) * factorialMP(k) * factorialMP(k - 1) * factorialMP(i - k) * factorialMP(2 * k - i);
+        s += num / den;
+    }
+    return ((i + N / 2) % 2 == 0 ? 1 : -1) * s;
+}
+
+// 扩展精度权重表: weights[N][i-1] = Vi (只计算一次，之后只读)
+struct ExtendedStehfestTable {
+    std::vector<QuadFloat> weights[LaplaceInversion::MaxExtendedStehfestN + 1];
+};
+
+const ExtendedStehfestTable& extendedStehfestTable()
+{
+    static const ExtendedStehfestTable table = []() {
+        ExtendedStehfestTable t;
+        for (int n = 2; n <= LaplaceInversion::MaxExtendedStehfestN; n += 2) {
+            t.weights[n].resize(n);
+            for (int i = 1; i <= n; ++i) {
+                t.weights[n][i - 1] = QuadFloat(extendedStehfestCoefficient(i, n));
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+// de Hoog 合成所用的临时数组 (每个线程一份，只增长不收缩，invert 仍为 const 且可重入)
+struct DeHoogScratch {
+    std::vector<LaplaceInversionMethod::Complex> e, q, d, A, B;
+};
+
+DeHoogScratch& deHoogScratch()
+{
+    thread_local DeHoogScratch scratch;
+    return scratch;
+}
+
+} // namespace
+
+const double* LaplaceInversion::stehfestWeights(int N)
+{
+    if (N < 2 || N > MaxStehfestN || N % 2 != 0) return nullptr;
+
+    // 局部静态变量的初始化是线程安全的，整张表只计算一次
+    static const StehfestTable table = []() {
+        StehfestTable t;
+        for (int n = 2; n <= MaxStehfestN; n += 2) {
+            for (int i = 1; i <= n; ++i) {
+                t.weights[n][i - 1] = (double)stehfestCoefficient(i, n);
+            }
+        }
+        return t;
+    }();
+    return table.weights[N];
+}
+
+long double LaplaceInversion::stehfestCoefficient(int i, int N)
+{
+    long double s = 0.0L;
+    int k1 = (i + 1) / 2;
+    int k2 = std::min(i, N / 2);
+    for (int k = k1; k <= k2; ++k) {
+        long double num = std::pow((long double)k, (long double)(N / 2)) * factorialLD(2 * k);
+        long double den = factorialLD(N / 2 - k) * factorialLD(k) * factorialLD(k - 1) * factorialLD(i - k) * factorialLD(2 * k - i);
+        if (den != 0) s += num / den;
+    }
+    return ((i + N / 2) % 2 == 0 ? 1.0L : -1.0L) * s;
+}
+
+// ---------------- Stehfest ----------------
+
+StehfestInversion::StehfestInversion(int N)
+    : m_N(N)
+{
+    if (N % 2 != 0 || N < 2 || N > LaplaceInversion::MaxStehfestN) m_N = 4;
+    m_weights = LaplaceInversion::stehfestWeights(m_N);
+}
+
+void StehfestInversion::nodes(double t, Complex* s) const
+{
+    double ln2 = std::log(2.0);
+    for (int m = 1; m <= m_N; ++m) s[m - 1] = m * ln2 / t;
+}
+
+double StehfestInversion::invert(double t, const Complex* F) const
+{
+    double ln2 = std::log(2.0);
+    double sum = 0.0;
+    for (int m = 1; m <= m_N; ++m) {
+        sum += m_weights[m - 1] * F[m - 1].real();
+    }
+    return sum * ln2 / t;
+}
+
+// ---------------- 扩展精度 Stehfest ----------------
+
+ExtendedStehfestInversion::ExtendedStehfestInversion(int N)
+    : m_N(N)
+{
+    if (N % 2 != 0 || N < 2 || N > LaplaceInversion::MaxExtendedStehfestN) m_N = 16;
+    extendedStehfestTable(); // 提前建表，避免首次求值时在多个线程中等待
+}
+
+void ExtendedStehfestInversion::nodes(double t, Complex* s) const
+{
+    double ln2 = std::log(2.0);
+    for (int m = 1; m <= m_N; ++m) s[m - 1] = m * ln2 / t;
+}
+
+double ExtendedStehfestInversion::invert(double t, const Complex* F) const
+{
+    const ExtendedStehfestTable& table = extendedStehfestTable();
+    const std::vector<QuadFloat>& w = table.weights[m_N];
+    QuadFloat sum = 0;
+    for (int m = 1; m <= m_N; ++m) {
+        sum += w[m - 1] * F[m - 1].real();
+    }
+    // 节点按 double 的 ln2/t 生成，合成时使用同一个 double 因子，保持与节点一致
+    double ln2 = std::log(2.0);
+    return static_cast<double>(sum) * ln2 / t;
+}
+
+// ---------------- 固定 Talbot ----------------
+
+TalbotInversion::TalbotInversion(int M)
+    : m_M(std::max(M, 2))
+{
+    m_theta.resize(m_M);
+    m_cot.resize(m_M);
+    m_sigma.resize(m_M);
+    for (int k = 1; k < m_M; ++k) {
+        double theta = k * M_PI / m_M;
+        double cot = 1.0 / std::tan(theta);
+        m_theta[k] = theta;
+        m_cot[k] = cot;
+        m_sigma[k] = theta + (theta * cot - 1.0) * cot;
+    }
+}
+
+void TalbotInversion::nodes(double t, Complex* s) const
+{
+    double r = 2.0 * m_M / (5.0 * t);
+    s[0] = r;
+    for (int k = 1; k < m_M; ++k) {
+        s[k] = r * m_theta[k] * Complex(m_cot[k], 1.0);
+    }
+}
+
+double TalbotInversion::invert(double t, const Complex* F) const
+{
+    double r = 2.0 * m_M / (5.0 * t);
+    double sum = 0.5 * std::exp(r * t) * F[0].real();
+    for (int k = 1; k < m_M; ++k) {
+        Complex s = r * m_theta[k] * Complex(m_cot[k], 1.0);
+        sum += (std::exp(t * s) * F[k] * Complex(1.0, m_sigma[k])).real();
+    }
+    return r / m_M * sum;
+}
+
+// ---------------- de Hoog ----------------
+
+DeHoogInversion::DeHoogInversion(int M, double tolerance)
+    : m_M(std::max(M, 1))
+    , m_tolerance(tolerance > 0.0 && tolerance < 1.0 ? tolerance : 1e-9)
+{
+}
+
+void DeHoogInversion::nodes(double t, Complex* s) const
+{
+    double T = 2.0 * t;
+    double gamma = -std::log(m_tolerance) / (2.0 * T);
+    for (int k = 0; k < 2 * m_M + 1; ++k) {
+        s[k] = Complex(gamma, M_PI * k / T);
+    }
+}
+
+double DeHoogInversion::invert(double t, const Complex* F) const
+{
+    const int M = m_M;
+    const int np = 2 * M + 1;
+    double T = 2.0 * t;
+    double gamma = -std::log(m_tolerance) / (2.0 * T);
+
+    // QD 表: e[i][r] (r = 0..M)，q[i][r] (r = 0..M-1)，按列递推
+    DeHoogScratch& scratch = deHoogScratch();
+    std::vector<Complex>& e = scratch.e;
+    std::vector<Complex>& q = scratch.q;
+    e.assign(np * (M + 1), Complex(0.0));
+    q.assign(2 * M * M, Complex(0.0));
+    auto E = [&](int i, int r) -> Complex& { return e[i * (M + 1) + r]; };
+    auto Q = [&](int i, int r) -> Complex& { return q[i * M + r]; };
+
+    Q(0, 0) = F[1] / (0.5 * F[0]);
+    for (int i = 1; i < 2 * M; ++i) Q(i, 0) = F[i + 1] / F[i];
+
+    // 菱形法则
+    for (int r = 1; r <= M; ++r) {
+        int mr = 2 * (M - r) + 1;
+        for (int i = 0; i < mr; ++i) E(i, r) = Q(i + 1, r - 1) - Q(i, r - 1) + E(i + 1, r - 1);
+        if (r < M) {
+            int mq = 2 * (M - r);
+            for (int i = 0; i < mq; ++i) Q(i, r) = Q(i + 1, r - 1) * E(i + 1, r) / E(i, r);
+        }
+    }
+
+    // 连分式系数
+    std::vector<Complex>& d = scratch.d;
+    d.assign(np, Complex(0.0));
+    d[0] = 0.5 * F[0];
+    for (int r = 1; r <= M; ++r) {
+        d[2 * r - 1] = -Q(0, r - 1);
+        d[2 * r] = -E(0, r);
+    }
+
+    // A、B 三项递推 (最后一项使用改进余项)
+    std::vector<Complex>& A = scratch.A;
+    std::vector<Complex>& B = scratch.B;
+    A.assign(np + 1, Complex(0.0));
+    B.assign(np + 1, Complex(0.0));
+    A[0] = 0.0; A[1] = d[0];
+    B[0] = 1.0; B[1] = 1.0;
+    Complex z = std::exp(Complex(0.0, M_PI * t / T));
+    for (int i = 1; i < 2 * M; ++i) {
+        A[i + 1] = A[i] + d[i] * A[i - 1] * z;
+        B[i + 1] = B[i] + d[i] * B[i - 1] * z;
+    }
+    Complex brem = 0.5 * (1.0 + (d[2 * M - 1] - d[2 * M]) * z);
+    Complex rem = brem * (std::sqrt(1.0 + d[2 * M] * z / (brem * brem)) - 1.0);
+    A[np] = A[2 * M] + rem * A[2 * M - 1];
+    B[np] = B[2 * M] + rem * B[2 * M - 1];
+
+    return std::exp(gamma * t) / T * (A[np] / B[np]).real();
+}
+
+// ---------------- Euler ----------------
+
+EulerInversion::EulerInversion(int M)
+    : m_M(std::max(M, 1))
+{
+    // ξ_0 = 1/2，ξ_k = 1 (1 <= k <= M)，ξ_2M = 2^-M，ξ_(2M-k) = ξ_(2M-k+1) + 2^-M·C(M, k)
+    const int M2 = 2 * m_M;
+    std::vector<double> xi(M2 + 1, 1.0);
+    xi[0] = 0.5;
+    double pow2 = std::pow(2.0, -m_M);
+    xi[M2] = pow2;
+    double binom = 1.0; // C(M, k)
+    for (int k = 1; k < m_M; ++k) {
+        binom = binom * (m_M - k + 1) / k;
+        xi[M2 - k] = xi[M2 - k + 1] + pow2 * binom;
+    }
+    m_eta.resize(M2 + 1);
+    for (int k = 0; k <= M2; ++k) m_eta[k] = (k % 2 == 0 ? 1.0 : -1.0) * xi[k];
+}
+
+void EulerInversion::nodes(double t, Complex* s) const
+{
+    double beta0 = m_M * std::log(10.0) / 3.0;
+    for (int k = 0; k <= 2 * m_M; ++k) {
+        s[k] = Complex(beta0, M_PI * k) / t;
+    }
+}
+
+double EulerInversion::invert(double t, const Complex* F) const
+{
+    double sum = 0.0;
+    for (int k = 0; k <= 2 * m_M; ++k) sum += m_eta[k] * F[k].real();
+    return std::pow(10.0, m_M / 3.0) / t * sum;
+}
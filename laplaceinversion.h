@@ -0,0 +1,150 @@
+/*
+ * laplaceinversion.h
+ * 文件作用：拉普拉斯数值反演工具头文件
+ * 功能描述：
+ * 1. 提供 Stehfest 反演权重 Vi 的预计算表 (N = 2, 4, ..., 20)
+ * 2. 权重在首次使用时以 long double 一次性计算并缓存，之后只读，可多线程共享
+ * 3. 定义反演方法的公共接口 LaplaceInversionMethod：先给出时间 t 所需的拉普拉斯节点 s_j，
+ *    调用方求出 F(s_j) 后再由 invert 合成 f(t)。节点求值与合成分离，便于并行与缓存
+ * 4. 内置四种方法: Stehfest (实数节点)、固定 Talbot 围道、de Hoog-Knight-Stokes、Euler 求和
+ * 5. 扩展精度 Stehfest: 权重与加权求和使用 113 位二进制浮点 (boost::multiprecision)，N 可取到 24
+ */
+
+#ifndef LAPLACEINVERSION_H
+#define LAPLACEINVERSION_H
+
+#include <complex>
+#include <vector>
+
+class LaplaceInversion
+{
+public:
+    // 反演方法
+    enum Method {
+        Stehfest = 0, // Gaver-Stehfest，N 个实数节点 (默认，与历史结果一致)
+        Talbot,       // 固定 Talbot 围道 (Abate & Valkó 2004)，M 个复数节点
+        DeHoog,       // de Hoog-Knight-Stokes 加速傅里叶级数 (1982)，2M+1 个复数节点
+        Euler,        // Euler 求和的 Bromwich 积分 (Abate & Whitt 2006)，2M+1 个复数节点
+        StehfestExtended // 扩展精度 Gaver-Stehfest，N 个实数节点 (N 最大 24，用于生成参考曲线)
+    };
+
+    // 支持的最大 Stehfest 项数 (20! 仍可在 long double 中精确表示)
+    static const int MaxStehfestN = 20;
+    // 扩展精度 Stehfest 支持的最大项数
+    static const int MaxExtendedStehfestN = 24;
+
+    // 获取 N 项 Stehfest 权重，返回数组下标 0 对应 V1
+    // N 必须为 [2, MaxStehfestN] 范围内的偶数，否则返回 nullptr
+    static const double* stehfestWeights(int N);
+
+private:
+    // 单个权重 Vi 的计算 (Stehfest 公式，long double 精度)
+    static long double stehfestCoefficient(int i, int N);
+};
+
+// 反演方法公共接口 (实现均为只读对象，可被多个线程同时使用)
+class LaplaceInversionMethod
+{
+public:
+    typedef std::complex<double> Complex;
+
+    virtual ~LaplaceInversionMethod() {}
+
+    // 每个时间点所需的拉普拉斯样本个数
+    virtual int nodeCount() const = 0;
+    // 节点是否为复数 (为 false 时调用方可只计算实数 F(s))
+    virtual bool usesComplexNodes() const = 0;
+    // 写出时间 t 的全部节点 s[0..nodeCount-1]
+    virtual void nodes(double t, Complex* s) const = 0;
+    // 由节点处的样本 F[j] = F(s[j]) 合成 f(t)
+    virtual double invert(double t, const Complex* F) const = 0;
+};
+
+// Gaver-Stehfest: s_j = j·ln2/t，f(t) = ln2/t·Σ V_j·F(s_j)
+class StehfestInversion : public LaplaceInversionMethod
+{
+public:
+    explicit StehfestInversion(int N); // N 需为 [2, MaxStehfestN] 内的偶数，否则取 4
+
+    int nodeCount() const override { return m_N; }
+    bool usesComplexNodes() const override { return false; }
+    void nodes(double t, Complex* s) const override;
+    double invert(double t, const Complex* F) const override;
+
+private:
+    int m_N;
+    const double* m_weights;
+};
+
+// 扩展精度 Gaver-Stehfest: 节点与 StehfestInversion 相同，权重 Vi 以 50 位十进制精度计算后
+// 保存为 113 位二进制浮点，Σ Vi·F(s_i) 也在该精度下累加，消除 double 权重舍入 (ε·Σ|Vi|) 带来的抵消误差。
+// 注意 F(s_i) 本身仍为 double，其舍入误差同样被 Σ|Vi| 放大 (N=16 约 1e7，N=24 约 1e11)，
+// 因此大 N 的实际精度受限于拉普拉斯解本身的精度: 双精度 F(s) 下 N=18 附近误差最小，
+// 更高精度的参考曲线应使用 Talbot / de Hoog
+class ExtendedStehfestInversion : public LaplaceInversionMethod
+{
+public:
+    explicit ExtendedStehfestInversion(int N); // N 需为 [2, MaxExtendedStehfestN] 内的偶数，否则取 16
+
+    int nodeCount() const override { return m_N; }
+    bool usesComplexNodes() const override { return false; }
+    void nodes(double t, Complex* s) const override;
+    double invert(double t, const Complex* F) const override;
+
+private:
+    int m_N;
+};
+
+// 固定 Talbot: s(θ) = r·θ·(cotθ + i)，r = 2M/(5t)，θ_k = kπ/M
+// 双精度下 M = 16~32 较合适，更大的 M 会因 e^(rt) 放大舍入误差而失去精度
+class TalbotInversion : public LaplaceInversionMethod
+{
+public:
+    explicit TalbotInversion(int M);
+
+    int nodeCount() const override { return m_M; }
+    bool usesComplexNodes() const override { return true; }
+    void nodes(double t, Complex* s) const override;
+    double invert(double t, const Complex* F) const override;
+
+private:
+    int m_M;
+    std::vector<double> m_theta;
+    std::vector<double> m_cot;
+    std::vector<double> m_sigma; // σ(θ) = θ + (θ·cotθ - 1)·cotθ
+};
+
+// de Hoog-Knight-Stokes: s_k = γ + iπk/T，T = 2t，γ = -ln(tolerance)/(2T)，
+// 用 QD 算法把傅里叶级数转化为连分式并以改进余项加速
+class DeHoogInversion : public LaplaceInversionMethod
+{
+public:
+    DeHoogInversion(int M, double tolerance);
+
+    int nodeCount() const override { return 2 * m_M + 1; }
+    bool usesComplexNodes() const override { return true; }
+    void nodes(double t, Complex* s) const override;
+    double invert(double t, const Complex* F) const override;
+
+private:
+    int m_M;
+    double m_tolerance;
+};
+
+// Euler 求和: s_k = (M·ln10/3 + iπk)/t，f(t) = 10^(M/3)/t·Σ η_k·Re F(s_k)
+class EulerInversion : public LaplaceInversionMethod
+{
+public:
+    explicit EulerInversion(int M);
+
+    int nodeCount() const override { return 2 * m_M + 1; }
+    bool usesComplexNodes() const override { return true; }
+    void nodes(double t, Complex* s) const override;
+    double invert(double t, const Complex* F) const override;
+
+private:
+    int m_M;
+    std::vector<double> m_eta;
+};
+
+#endif // LAPLACEINVERSION_H
@@ -0,0 +1,56 @@
+/*
+ * laplacesamplecache.cpp
+ * 文件作用：拉普拉斯空间样本缓存实现
+ */
+
+#include "laplacesamplecache.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <cstring>
+
+bool LaplaceSampleCache::Key::operator==(const Key& other) const
+{
+    return std::memcmp(v, other.v, sizeof(v)) == 0 && layout.size() == other.layout.size()
+        && std::memcmp(layout.constData(), other.layout.constData(), layout.size() * sizeof(double)) == 0;
+}
+
+size_t qHash(const LaplaceSampleCache::Key& key, size_t seed)
+{
+    size_t h = qHashBits(key.v, sizeof(key.v), seed);
+    if (!key.layout.isEmpty()) h = qHashBits(key.layout.constData(), key.layout.size() * sizeof(double), h);
+    return h;
+}
+
+LaplaceSampleCache::LaplaceSampleCache(int capacity)
+    : m_capacity(capacity)
+{
+}
+
+bool LaplaceSampleCache::lookup(const Key& key, std::complex<double>& value) const
+{
+    QReadLocker locker(&m_lock);
+    auto it = m_values.constFind(key);
+    if (it == m_values.constEnd()) return false;
+    value = it.value();
+    return true;
+}
+
+void LaplaceSampleCache::insert(const Key& key, const std::complex<double>& value)
+{
+    QWriteLocker locker(&m_lock);
+    if (m_values.size() >= m_capacity) m_values.clear();
+    m_values.insert(key, value);
+}
+
+void LaplaceSampleCache::clear()
+{
+    QWriteLocker locker(&m_lock);
+    m_values.clear();
+}
+
+int LaplaceSampleCache::size() const
+{
+    QReadLocker locker(&m_lock);
+    return m_values.size();
+}
@@ -0,0 +1,51 @@
+/*
+ * laplacesamplecache.h
+ * 文件作用：拉普拉斯空间样本缓存头文件
+ * 功能描述：
+ * 1. 缓存不含井储/表皮的 PWD_composite 结果，键为 (相关模型参数, z)；
+ *    z 与结果均按复数存储，实数 (Stehfest) 与复数 (Talbot 等) 节点共用同一缓存
+ * 2. 拟合求雅可比矩阵时，仅扰动 cD、S、gamaD 等参数不会改变裂缝解，
+ *    可直接复用缓存，避免重复求解 nf×nf 积分矩阵
+ * 3. 读写锁保护，可被多个工作线程同时访问
+ */
+
+#ifndef LAPLACESAMPLECACHE_H
+#define LAPLACESAMPLECACHE_H
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVector>
+#include <complex>
+
+class LaplaceSampleCache
+{
+public:
+    // 缓存键: 参与 PWD 计算的全部参数按位比较；任意裂缝布局的位置与半长数组也逐项比较 (等间距布局为空)
+    struct Key {
+        enum { Size = 10 };
+        double v[Size];
+        QVector<double> layout;
+
+        bool operator==(const Key& other) const;
+    };
+
+    explicit LaplaceSampleCache(int capacity = 65536);
+
+    // 查询缓存，命中时写入 value 并返回 true
+    bool lookup(const Key& key, std::complex<double>& value) const;
+
+    // 写入缓存，超过容量时整体清空后重新累积
+    void insert(const Key& key, const std::complex<double>& value);
+
+    void clear();
+    int size() const;
+
+private:
+    mutable QReadWriteLock m_lock;
+    QHash<Key, std::complex<double>> m_values;
+    int m_capacity;
+};
+
+size_t qHash(const LaplaceSampleCache::Key& key, size_t seed = 0);
+
+#endif // LAPLACESAMPLECACHE_H
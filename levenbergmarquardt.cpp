@@ -0,0 +1,352 @@
+/*
+ * levenbergmarquardt.cpp
+ * 文件作用：有界非线性最小二乘 (Levenberg-Marquardt) 求解器实现
+ * 功能描述：
+ * 1. 阻尼矩阵取 μ·D，D 为历次 JᵀJ 对角元的最大值 (Moré 缩放)，参数量纲差异大时步长仍合理
+ * 2. 由实际步长 d 计算线性模型的预测下降 -gᵀd - ½dᵀJᵀJd，投影截断或加速修正后的步长同样适用
+ * 3. 接受步 (ρ > 0) 后 μ ← μ·max(1/3, 1 - (2ρ - 1)³)，ν ← 2；拒绝步 μ ← μ·ν，ν ← 2ν
+ * 4. 差分雅可比总在外部变量空间按给定步长计算 (靠近边界时改为向内的单侧差分)，
+ *    变量变换时再乘以 dx/dy 得到内部变量的雅可比
+ */
+
+#include "levenbergmarquardt.h"
+
+#include <Eigen/Dense>
+
+#include <QtConcurrent>
+#include <QThreadPool>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+namespace {
+
+const double MaxDamping = 1e16; // 阻尼超过该值仍不能下降时终止
+
+// 单个变量的边界映射 (外部 x ↔ 内部 y)
+struct BoundMap {
+    enum Kind { Free, Both, LowerOnly, UpperOnly };
+    Kind kind;
+    double lower;
+    double upper;
+
+    double toExternal(double y) const
+    {
+        switch (kind) {
+        case Both: return lower + (upper - lower) * (std::sin(y) + 1.0) / 2.0;
+        case LowerOnly: return lower - 1.0 + std::sqrt(y * y + 1.0);
+        case UpperOnly: return upper + 1.0 - std::sqrt(y * y + 1.0);
+        default: return y;
+        }
+    }
+
+    double toInternal(double x) const
+    {
+        switch (kind) {
+        case Both: return std::asin(qBound(-1.0, 2.0 * (x - lower) / (upper - lower) - 1.0, 1.0));
+        case LowerOnly: { double s = x - lower + 1.0; return std::sqrt(std::max(s * s - 1.0, 0.0)); }
+        case UpperOnly: { double s = upper - x + 1.0; return std::sqrt(std::max(s * s - 1.0, 0.0)); }
+        default: return x;
+        }
+    }
+
+    // dx/dy
+    double derivative(double y) const
+    {
+        switch (kind) {
+        case Both: return (upper - lower) * std::cos(y) / 2.0;
+        case LowerOnly: return y / std::sqrt(y * y + 1.0);
+        case UpperOnly: return -y / std::sqrt(y * y + 1.0);
+        default: return 1.0;
+        }
+    }
+};
+
+bool isFiniteVector(const QVector<double>& v)
+{
+    for (double x : v) if (!std::isfinite(x)) return false;
+    return true;
+}
+
+} // namespace
+
+LevenbergMarquardtSolver::LevenbergMarquardtSolver(const LevenbergMarquardtConfig& config)
+    : m_config(config)
+{
+}
+
+void LevenbergMarquardtSolver::setBounds(const QVector<double>& lower, const QVector<double>& upper)
+{
+    m_lower = lower;
+    m_upper = upper;
+}
+
+void LevenbergMarquardtSolver::setDifferenceSteps(const QVector<double>& steps)
+{
+    m_steps = steps;
+}
+
+FitStatistics LevenbergMarquardtSolver::minimize(const ResidualFunction& residuals, QVector<double>& x) const
+{
+    FitStatistics stats;
+    const int n = x.size();
+    const double inf = std::numeric_limits<double>::infinity();
+    const bool transform = (m_config.boundHandling == BoundHandling::Transformation);
+
+    // 边界与映射 (投影方式下内部变量即外部变量)
+    QVector<double> lower(n, -inf), upper(n, inf);
+    QVector<BoundMap> maps(n);
+    for (int j = 0; j < n; ++j) {
+        if (j < m_lower.size() && !std::isnan(m_lower[j])) lower[j] = m_lower[j];
+        if (j < m_upper.size() && !std::isnan(m_upper[j])) upper[j] = m_upper[j];
+        x[j] = qBound(lower[j], x[j], upper[j]);
+        bool hasLower = std::isfinite(lower[j]), hasUpper = std::isfinite(upper[j]);
+        BoundMap& b = maps[j];
+        b.lower = lower[j]; b.upper = upper[j];
+        if (!transform || (!hasLower && !hasUpper)) b.kind = BoundMap::Free;
+        else if (hasLower && hasUpper) b.kind = (upper[j] > lower[j]) ? BoundMap::Both : BoundMap::Free;
+        else b.kind = hasLower ? BoundMap::LowerOnly : BoundMap::UpperOnly;
+    }
+    auto toExternal = [&](const Eigen::VectorXd& y) {
+        QVector<double> ext(n);
+        for (int j = 0; j < n; ++j) ext[j] = maps[j].toExternal(y(j));
+        return ext;
+    };
+    Eigen::VectorXd y(n);
+    for (int j = 0; j < n; ++j) y(j) = maps[j].toInternal(x[j]);
+
+    // 残差求值 (长度与初始残差不一致或含非有限值视为失败)
+    int m = 0;
+    auto evaluate = [&](const QVector<double>& point, Eigen::VectorXd& r) {
+        QVector<double> values = residuals(point, false);
+        stats.residualEvaluations++;
+        if (values.isEmpty() || (m > 0 && values.size() != m) || !isFiniteVector(values)) return false;
+        r = Eigen::Map<const Eigen::VectorXd>(values.constData(), values.size());
+        return true;
+    };
+
+    // 外部变量空间的差分雅可比，各列的扰动点整批并发求值
+    auto differenceJacobian = [&](const QVector<double>& point, const Eigen::VectorXd& r0, bool central, Eigen::MatrixXd& J) {
+        struct Probe {
+            int column;
+            double offset;
+        };
+        QVector<Probe> probes;
+        QVector<double> steps(n);
+        QVector<char> centered(n);
+        for (int j = 0; j < n; ++j) {
+            double h = (j < m_steps.size() && m_steps[j] > 0.0) ? m_steps[j] : 1e-6 * std::max(1.0, std::abs(point[j]));
+            bool plusInside = point[j] + h <= upper[j];
+            bool minusInside = point[j] - h >= lower[j];
+            centered[j] = central && plusInside && minusInside;
+            if (centered[j]) {
+                Probe plus = { j, h }; Probe minus = { j, -h };
+                probes.append(plus); probes.append(minus);
+            } else {
+                // 单侧差分，靠近上界时向内取负步长
+                if (!plusInside && minusInside) h = -h;
+                Probe p = { j, h };
+                probes.append(p);
+            }
+            steps[j] = h;
+        }
+
+        QVector<QVector<double>> values(probes.size());
+        const bool concurrent = m_config.concurrentJacobian;
+        bool saturated = concurrent && probes.size() >= QThreadPool::globalInstance()->maxThreadCount();
+        auto evaluateProbe = [&](int k) {
+            QVector<double> shifted = point;
+            shifted[probes[k].column] += probes[k].offset;
+            values[k] = residuals(shifted, saturated);
+        };
+        if (concurrent) {
+            QVector<int> order(probes.size());
+            std::iota(order.begin(), order.end(), 0);
+            QtConcurrent::blockingMap(order, evaluateProbe);
+        } else {
+            for (int k = 0; k < probes.size(); ++k) evaluateProbe(k);
+        }
+        stats.residualEvaluations += probes.size();
+        stats.jacobianEvaluations++;
+
+        J.setZero(m, n);
+        auto usable = [&](const QVector<double>& v) { return v.size() == m && isFiniteVector(v); };
+        for (int k = 0, j = 0; j < n; ++j) {
+            if (centered[j]) {
+                const QVector<double>& rPlus = values[k++];
+                const QVector<double>& rMinus = values[k++];
+                if (!usable(rPlus) || !usable(rMinus)) continue; // 求值失败的列取 0
+                for (int i = 0; i < m; ++i) J(i, j) = (rPlus[i] - rMinus[i]) / (2.0 * steps[j]);
+            } else {
+                const QVector<double>& rStep = values[k++];
+                if (!usable(rStep)) continue;
+                for (int i = 0; i < m; ++i) J(i, j) = (rStep[i] - r0(i)) / steps[j];
+            }
+        }
+    };
+
+    // 初始点
+    Eigen::VectorXd r;
+    if (!evaluate(x, r)) {
+        stats.termination = FitTermination::EvaluationFailed;
+        return stats;
+    }
+    m = r.size();
+    double cost = 0.5 * r.squaredNorm();
+    stats.initialError = stats.finalError = 2.0 * cost / m;
+    if (m_iterationCallback) m_iterationCallback(0, x, stats.finalError);
+    if (m_config.targetMeanSquare > 0.0 && stats.finalError <= m_config.targetMeanSquare) {
+        stats.termination = FitTermination::TargetReached;
+        return stats;
+    }
+
+    // 线性化: 内部变量的雅可比 J、A = JᵀJ、梯度 g = Jᵀr 与缩放 D
+    const bool broyden = (m_config.jacobian == JacobianStrategy::Broyden);
+    const bool central = (m_config.jacobian == JacobianStrategy::CentralDifference);
+    Eigen::MatrixXd J, A;
+    Eigen::VectorXd g, D = Eigen::VectorXd::Zero(n);
+    bool jacobianFresh = false;
+    int updatesSinceRefresh = 0;
+    auto refreshJacobian = [&]() {
+        differenceJacobian(x, r, central, J);
+        if (transform) {
+            for (int j = 0; j < n; ++j) J.col(j) *= maps[j].derivative(y(j));
+        }
+        jacobianFresh = true;
+        updatesSinceRefresh = 0;
+    };
+    auto linearize = [&]() {
+        A.noalias() = J.transpose() * J;
+        g.noalias() = J.transpose() * r;
+        double maxDiagonal = A.diagonal().maxCoeff();
+        double floor = (maxDiagonal > 0.0) ? 1e-12 * maxDiagonal : 1.0;
+        for (int j = 0; j < n; ++j) D(j) = std::max(std::max(D(j), A(j, j)), floor);
+    };
+    refreshJacobian();
+    linearize();
+
+    double mu = m_config.initialDamping;
+    double nu = 2.0;
+    while (true) {
+        if (m_stopCallback && m_stopCallback()) { stats.termination = FitTermination::Stopped; break; }
+        if (stats.iterations >= m_config.maxIterations) { stats.termination = FitTermination::MaxIterations; break; }
+        if (m_config.maxEvaluations > 0 && stats.residualEvaluations >= m_config.maxEvaluations) {
+            stats.termination = FitTermination::MaxEvaluations;
+            break;
+        }
+
+        // 投影方式下停在边界上且梯度指向界外的变量本步固定 (活动集)，梯度判据也忽略这些分量
+        QVector<char> active(n, 0);
+        double gradientNorm = 0.0;
+        for (int j = 0; j < n; ++j) {
+            if (!transform && ((y(j) <= lower[j] && g(j) > 0.0) || (y(j) >= upper[j] && g(j) < 0.0))) {
+                active[j] = 1;
+                continue;
+            }
+            gradientNorm = std::max(gradientNorm, std::abs(g(j)));
+        }
+        if (gradientNorm <= m_config.gradientTolerance) {
+            if (broyden && !jacobianFresh) { refreshJacobian(); linearize(); continue; }
+            stats.termination = FitTermination::GradientTolerance;
+            break;
+        }
+
+        stats.iterations++;
+        Eigen::MatrixXd M = A;
+        M.diagonal() += mu * D;
+        for (int j = 0; j < n; ++j) {
+            if (!active[j]) continue;
+            M.row(j).setZero(); M.col(j).setZero(); M(j, j) = 1.0;
+        }
+        Eigen::LDLT<Eigen::MatrixXd> ldlt(M);
+        auto solveFree = [&](Eigen::VectorXd rhs) {
+            for (int j = 0; j < n; ++j) if (active[j]) rhs(j) = 0.0;
+            return Eigen::VectorXd(ldlt.solve(rhs));
+        };
+        Eigen::VectorXd v = solveFree(-g);
+        bool accepted = false;
+        bool rejected = (ldlt.info() != Eigen::Success) || !v.allFinite();
+
+        if (!rejected && v.norm() <= m_config.stepTolerance * (y.norm() + m_config.stepTolerance)) {
+            if (broyden && !jacobianFresh) { refreshJacobian(); linearize(); continue; }
+            stats.termination = FitTermination::StepTolerance;
+            break;
+        }
+
+        // 测地线加速: r_vv ≈ (2/h)·((r(y + h·v) - r)/h - J·v)，(A + μD)·a = -Jᵀr_vv，步长 d = v + a/2
+        Eigen::VectorXd d = v;
+        if (!rejected && m_config.geodesicAcceleration) {
+            double h = m_config.accelerationStep;
+            Eigen::VectorXd yh = y + h * v;
+            if (!transform) for (int j = 0; j < n; ++j) yh(j) = qBound(lower[j], yh(j), upper[j]);
+            Eigen::VectorXd rh;
+            if (evaluate(toExternal(yh), rh)) {
+                Eigen::VectorXd rvv = (2.0 / h) * ((rh - r) / h - J * v);
+                Eigen::VectorXd a = solveFree(-(J.transpose() * rvv));
+                if (a.allFinite() && 2.0 * a.norm() <= m_config.accelerationRatio * v.norm()) d += 0.5 * a;
+                else rejected = true;
+            }
+        }
+
+        Eigen::VectorXd yNew, rNew;
+        QVector<double> xNew;
+        double costNew = 0.0;
+        if (!rejected) {
+            yNew = y + d;
+            if (!transform) for (int j = 0; j < n; ++j) yNew(j) = qBound(lower[j], yNew(j), upper[j]);
+            Eigen::VectorXd step = yNew - y;
+            double predicted = -g.dot(step) - 0.5 * step.dot(A * step);
+            xNew = toExternal(yNew);
+            if (predicted > 0.0 && evaluate(xNew, rNew)) {
+                costNew = 0.5 * rNew.squaredNorm();
+                double rho = (cost - costNew) / predicted;
+                if (rho > 0.0) {
+                    accepted = true;
+                    double reduction = (cost - costNew) / cost;
+                    if (broyden) {
+                        // 秩一割线更新 J += (Δr - J·Δy)·Δyᵀ / (Δyᵀ·Δy)；ρ < 1/4 说明割线模型已不可靠，下一次重新差分
+                        double stepNorm2 = step.squaredNorm();
+                        if (stepNorm2 > 0.0) {
+                            J += ((rNew - r - J * step) / stepNorm2) * step.transpose();
+                            stats.broydenUpdates++;
+                            updatesSinceRefresh++;
+                        }
+                        jacobianFresh = false;
+                        if (rho < 0.25) updatesSinceRefresh = m_config.broydenRefreshInterval;
+                    }
+                    y = yNew; x = xNew; r = rNew; cost = costNew;
+                    stats.acceptedSteps++;
+                    stats.finalError = 2.0 * cost / m;
+                    stats.errorHistory.append(stats.finalError);
+                    if (m_iterationCallback) m_iterationCallback(stats.iterations, x, stats.finalError);
+
+                    mu *= std::max(1.0 / 3.0, 1.0 - std::pow(2.0 * rho - 1.0, 3));
+                    nu = 2.0;
+                    if (m_config.targetMeanSquare > 0.0 && stats.finalError <= m_config.targetMeanSquare) {
+                        stats.termination = FitTermination::TargetReached;
+                        break;
+                    }
+                    if (reduction <= m_config.costTolerance) { stats.termination = FitTermination::CostTolerance; break; }
+
+                    if (!broyden || updatesSinceRefresh >= m_config.broydenRefreshInterval) refreshJacobian();
+                    linearize();
+                }
+            }
+        }
+
+        if (!accepted) {
+            if (broyden && !jacobianFresh) {
+                // 割线近似的雅可比可能已失真: 阻尼不变，先在当前点重新差分
+                refreshJacobian();
+                linearize();
+                continue;
+            }
+            mu *= nu;
+            nu *= 2.0;
+            if (mu > MaxDamping) { stats.termination = FitTermination::DampingLimit; break; }
+        }
+    }
+
+    return stats;
+}
@@ -0,0 +1,131 @@
+/*
+ * levenbergmarquardt.h
+ * 文件作用：有界非线性最小二乘 (Levenberg-Marquardt) 求解器头文件
+ * 功能描述：
+ * 1. 与界面无关，只通过残差回调 r(x) 访问模型，可在 FittingWidget 之外单独使用
+ * 2. 信赖域式阻尼: 按实际下降与线性模型预测下降之比 ρ 用 Nielsen 规则连续调整 μ，
+ *    拒绝步只加倍增长因子，不做固定次数的试探
+ * 3. 可选测地线加速 (Transtrum & Sethna): 沿速度方向的二阶方向导数修正步长，
+ *    每次试探多一次残差求值，适用于参数强相关、谷底狭长的问题
+ * 4. 收敛判据: 相对步长、(投影) 梯度无穷范数、相对下降量，另有目标均方误差、迭代与求值次数上限
+ * 5. 边界处理: 投影 (步长截断到边界，停在边界上且梯度指向界外的变量本步固定) 或变量变换 (正弦/平方根映射，内部无约束)
+ * 6. 雅可比: 中心差分、前向差分 (复用当前残差) 或 Broyden 秩一割线更新，差分列默认并发分发到全局线程池
+ */
+
+#ifndef LEVENBERGMARQUARDT_H
+#define LEVENBERGMARQUARDT_H
+
+#include <QVector>
+#include <functional>
+
+// 雅可比矩阵的求法
+enum class JacobianStrategy {
+    CentralDifference, // 每次线性化完整中心差分 (2·n 次残差求值)
+    ForwardDifference, // 前向差分，复用当前点的残差 (n 次)
+    Broyden            // 接受步后做秩一割线更新 (不求值)，到达刷新间隔、ρ < 1/4 或割线模型下试探失败时前向差分重算
+};
+
+// 参数边界的处理方式
+enum class BoundHandling {
+    Projection,     // 试探点逐分量截断到 [lower, upper]
+    Transformation  // 在无约束的内部变量上迭代: 双边界 x = l + (u-l)(sin y + 1)/2，单边界 x = l - 1 + sqrt(y² + 1)
+};
+
+// 终止原因
+enum class FitTermination {
+    StepTolerance,     // 相对步长小于 stepTolerance
+    GradientTolerance, // 梯度无穷范数小于 gradientTolerance
+    CostTolerance,     // 接受步的相对下降量小于 costTolerance
+    TargetReached,     // 均方误差达到 targetMeanSquare
+    MaxIterations,     // 达到最大试探次数
+    MaxEvaluations,    // 达到残差求值次数上限
+    DampingLimit,      // 阻尼增大到上限仍无法下降
+    Stopped,           // 调用方请求停止
+    EvaluationFailed   // 初始点残差求值失败
+};
+
+// 求解配置
+struct LevenbergMarquardtConfig {
+    int maxIterations;           // 最大试探次数 (接受与拒绝的步都计入)
+    int maxEvaluations;          // 残差求值次数上限 (含差分与加速项，0 表示不限)
+    double initialDamping;       // 初始阻尼 μ0 (相对于 JᵀJ 对角元的缩放)
+    double stepTolerance;        // 相对步长判据 ‖δ‖ <= tol·(‖x‖ + tol)
+    double gradientTolerance;    // 梯度判据 ‖Jᵀr‖∞ <= tol
+    double costTolerance;        // 相对下降判据 (C - C_new) <= tol·C
+    double targetMeanSquare;     // 均方误差 rᵀr/m 达到该值即停止 (0 表示不启用)
+    bool geodesicAcceleration;   // 是否启用测地线加速
+    double accelerationRatio;    // 加速项与速度项之比上限 2‖a‖/‖v‖ <= α，超出视为拒绝
+    double accelerationStep;     // 二阶方向导数的差分步长 h (沿速度方向)
+    BoundHandling boundHandling; // 边界处理方式
+    JacobianStrategy jacobian;   // 雅可比策略
+    int broydenRefreshInterval;  // Broyden 两次差分之间的最大割线更新次数
+    bool concurrentJacobian;     // 差分列是否并发分发到全局线程池 (调用方已在外层并发时设为 false，逐列串行求值)
+
+    LevenbergMarquardtConfig() :
+        maxIterations(100),
+        maxEvaluations(0),
+        initialDamping(1e-3),
+        stepTolerance(1e-6),
+        gradientTolerance(1e-8),
+        costTolerance(1e-6),
+        targetMeanSquare(0.0),
+        geodesicAcceleration(false),
+        accelerationRatio(0.75),
+        accelerationStep(0.1),
+        boundHandling(BoundHandling::Projection),
+        jacobian(JacobianStrategy::CentralDifference),
+        broydenRefreshInterval(5),
+        concurrentJacobian(true)
+    {}
+};
+
+// 一次拟合的结果与收敛统计 (用于比较不同策略)
+struct FitStatistics {
+    int iterations;               // 试探次数
+    int acceptedSteps;            // 接受的步数
+    int residualEvaluations;      // 残差求值次数 (每次为一条完整理论曲线，含差分与加速项)
+    int jacobianEvaluations;      // 差分雅可比的计算次数
+    int broydenUpdates;           // 割线更新次数
+    double initialError;          // 初始均方误差
+    double finalError;            // 最终均方误差
+    QVector<double> errorHistory; // 每次接受步后的均方误差
+    FitTermination termination;   // 终止原因
+
+    FitStatistics()
+        : iterations(0), acceptedSteps(0), residualEvaluations(0), jacobianEvaluations(0),
+          broydenUpdates(0), initialError(0.0), finalError(0.0), termination(FitTermination::MaxIterations) {}
+};
+
+class LevenbergMarquardtSolver
+{
+public:
+    // 残差函数: 返回 x 处的残差向量，求值失败时返回空向量 (或长度不一致)。
+    // 雅可比差分列会从线程池并发调用，函数须线程安全；concurrent 为 true 时表示调用方正在并发求值一批点
+    typedef std::function<QVector<double>(const QVector<double>& x, bool concurrent)> ResidualFunction;
+    // 初始点 (iteration = 0) 与每次接受步后回调: 试探序号、当前参数与均方误差
+    typedef std::function<void(int iteration, const QVector<double>& x, double meanSquare)> IterationCallback;
+    // 返回 true 时在下一次试探前终止
+    typedef std::function<bool()> StopCallback;
+
+    explicit LevenbergMarquardtSolver(const LevenbergMarquardtConfig& config = LevenbergMarquardtConfig());
+
+    // 参数上下界 (长度与 x 相同；为空或取 ±inf 表示无界)
+    void setBounds(const QVector<double>& lower, const QVector<double>& upper);
+    // 各参数的差分步长 (外部变量空间；为空时取 1e-6·max(1, |x|))
+    void setDifferenceSteps(const QVector<double>& steps);
+    void setIterationCallback(const IterationCallback& callback) { m_iterationCallback = callback; }
+    void setStopCallback(const StopCallback& callback) { m_stopCallback = callback; }
+
+    // 从 x0 开始最小化 ½‖r(x)‖²，x 返回最优点 (初始点超出边界时先截断)
+    FitStatistics minimize(const ResidualFunction& residuals, QVector<double>& x) const;
+
+private:
+    LevenbergMarquardtConfig m_config;
+    QVector<double> m_lower;
+    QVector<double> m_upper;
+    QVector<double> m_steps;
+    IterationCallback m_iterationCallback;
+    StopCallback m_stopCallback;
+};
+
+#endif // LEVENBERGMARQUARDT_H
@@ -405,6 +405,11 @@ void MainWindow::transferDataToFitting()
     }
 
     m_FittingPage->setObservedDataToCurrent(tVec, pVec, dVec);
+
+    // 图表页有阶梯产量数据时按变产量叠加拟合，否则按恒定产量
+    QVector<double> durations, rates;
+    if (m_PlottingWidget) m_PlottingWidget->getRateTable(durations, rates);
+    m_FittingPage->setRateHistoryToCurrent(durations, rates);
 }
 
 void MainWindow::onFittingProgressChanged(int progress)
@@ -23,9 +23,16 @@ ModelManager::ModelManager(QWidget* parent)
     : QObject(parent), m_mainWidget(nullptr), m_btnSelectModel(nullptr), m_modelStack(nullptr)
     , m_currentModelType(Model_1)
 {
+    // 计算引擎与界面无关，构造时即创建，保证未初始化界面时也可计算
+    for (int i = Model_1; i <= Model_6; ++i) {
+        m_modelEngines.append(new CompositeShaleModel((ModelType)i));
+    }
 }
 
-ModelManager::~ModelManager() {}
+ModelManager::~ModelManager()
+{
+    qDeleteAll(m_modelEngines);
+}
 
 void ModelManager::initializeModels(QWidget* parentWidget)
 {
@@ -221,23 +228,71 @@ QMap<QString, double> ModelManager::getDefaultParameters(ModelType type)
     return p;
 }
 
-ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime)
+const CompositeShaleModel* ModelManager::getModelEngine(ModelType type) const
 {
     int index = (int)type;
-    if (index >= 0 && index < m_modelWidgets.size()) {
-        return m_modelWidgets[index]->calculateTheoreticalCurve(params, providedTime);
+    if (index >= 0 && index < m_modelEngines.size()) {
+        return m_modelEngines[index];
+    }
+    return nullptr;
+}
+
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime, const ModelEvaluationConfig& config) const
+{
+    const CompositeShaleModel* engine = getModelEngine(type);
+    if (engine) {
+        return engine->calculateTheoreticalCurve(params, providedTime, config);
     }
     return ModelCurveData();
 }
 
-QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
-    QVector<double> t;
-    t.reserve(count);
-    for (int i = 0; i < count; ++i) {
-        double exponent = startExp + (endExp - startExp) * i / (count - 1);
-        t.append(pow(10.0, exponent));
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const CompositeModelParameters& params, const QVector<double>& providedTime, const ModelEvaluationConfig& config) const
+{
+    const CompositeShaleModel* engine = getModelEngine(type);
+    if (engine) {
+        return engine->calculateTheoreticalCurve(params, providedTime, config);
     }
-    return t;
+    return ModelCurveData();
+}
+
+void ModelManager::calculateTheoreticalCurve(ModelType type, const CompositeModelParameters& params, const QVector<double>& time,
+                                             const ModelEvaluationConfig& config,
+                                             QVector<double>& outPressure, QVector<double>& outDerivative) const
+{
+    const CompositeShaleModel* engine = getModelEngine(type);
+    if (engine) {
+        engine->calculateTheoreticalCurve(params, time, config, outPressure, outDerivative);
+        return;
+    }
+    outPressure.clear();
+    outDerivative.clear();
+}
+
+ModelCurveData ModelManager::calculateSuperposedCurve(ModelType type, const CompositeModelParameters& params, const RateHistory& history,
+                                                      const QVector<double>& providedTime, const ModelEvaluationConfig& config) const
+{
+    const CompositeShaleModel* engine = getModelEngine(type);
+    if (engine) {
+        return engine->calculateSuperposedCurve(params, history, providedTime, config);
+    }
+    return ModelCurveData();
+}
+
+void ModelManager::calculateSuperposedCurve(ModelType type, const CompositeModelParameters& params, const RateHistory& history,
+                                            const QVector<double>& time, const ModelEvaluationConfig& config,
+                                            QVector<double>& outPressure, QVector<double>& outDerivative) const
+{
+    const CompositeShaleModel* engine = getModelEngine(type);
+    if (engine) {
+        engine->calculateSuperposedCurve(params, history, time, config, outPressure, outDerivative);
+        return;
+    }
+    outPressure.clear();
+    outDerivative.clear();
+}
+
+QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
+    return CompositeShaleModel::generateLogTimeSteps(count, startExp, endExp);
 }
 
 void ModelManager::setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d)
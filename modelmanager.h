@@ -36,13 +36,34 @@ public:
     // 获取当前模型类型名称
     static QString getModelTypeName(ModelType type);
 
-    // 计算理论曲线接口 (供 FittingWidget 使用)
-    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+    // 计算理论曲线接口 (供 FittingWidget 使用，线程安全)
+    // 直接调用无界面计算引擎，精度/并行等配置由调用方传入，不依赖模型界面是否已创建
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params,
+                                             const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelEvaluationConfig& config = ModelEvaluationConfig()) const;
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const CompositeModelParameters& params,
+                                             const QVector<double>& providedTime = QVector<double>(),
+                                             const ModelEvaluationConfig& config = ModelEvaluationConfig()) const;
+    // 写入调用方缓冲区 (拟合残差计算中复用，不重新分配)
+    void calculateTheoreticalCurve(ModelType type, const CompositeModelParameters& params, const QVector<double>& time,
+                                   const ModelEvaluationConfig& config,
+                                   QVector<double>& outPressure, QVector<double>& outDerivative) const;
+
+    // 变产量叠加曲线 (线程安全)，history 只有一段时等价于恒定产量曲线
+    ModelCurveData calculateSuperposedCurve(ModelType type, const CompositeModelParameters& params, const RateHistory& history,
+                                            const QVector<double>& providedTime = QVector<double>(),
+                                            const ModelEvaluationConfig& config = ModelEvaluationConfig()) const;
+    void calculateSuperposedCurve(ModelType type, const CompositeModelParameters& params, const RateHistory& history,
+                                  const QVector<double>& time, const ModelEvaluationConfig& config,
+                                  QVector<double>& outPressure, QVector<double>& outDerivative) const;
+
+    // 获取指定模型的计算引擎 (可在工作线程中并发调用)
+    const CompositeShaleModel* getModelEngine(ModelType type) const;
 
     // 获取默认参数 (供 FittingWidget 使用)
     QMap<QString, double> getDefaultParameters(ModelType type);
 
-    // 设置所有模型的高精度模式
+    // 设置所有模型界面的高精度模式
     void setHighPrecision(bool high);
 
     // 刷新所有模型的基础参数
@@ -79,6 +100,9 @@ private:
     // 使用列表统一管理所有模型实例
     QVector<ModelWidget01_06*> m_modelWidgets;
 
+    // 每种模型对应一个无界面计算引擎
+    QVector<CompositeShaleModel*> m_modelEngines;
+
     ModelType m_currentModelType;
 
     // 数据缓存
@@ -0,0 +1,226 @@
+/*
+ * multistartsearch.cpp
+ * 文件作用：多起点全局搜索实现
+ * 功能描述：
+ * 1. 拉丁超立方: 每个变量的采样范围等分为 startCount 层，各层随机取一点后按随机排列分配给起点
+ * 2. 短 LM 与精细化均以起点为单位并发；某一阶段的求解数不少于线程数时 (通常是短 LM 阶段)，内层 LM 逐列串行求
+ *    差分雅可比、残差回调以 concurrent = true 调用，否则 (通常是只有少数几个的精细化) 保留求解器内部的并发
+ * 3. 全局最优点在锁内更新；同一时刻至多一个线程在锁外通知调用方，通知期间其他线程的改进由它在回调返回后
+ *    补发最新者，调用方看到的误差严格递减且最后一次总是全局最优；停止请求由每个求解器在下一次试探前响应
+ */
+
+#include "multistartsearch.h"
+
+#include <QtConcurrent>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <algorithm>
+
+MultiStartSearch::MultiStartSearch(const MultiStartConfig& config, const LevenbergMarquardtConfig& localConfig)
+    : m_config(config), m_localConfig(localConfig)
+{
+}
+
+void MultiStartSearch::setBounds(const QVector<double>& lower, const QVector<double>& upper)
+{
+    m_lower = lower;
+    m_upper = upper;
+}
+
+void MultiStartSearch::setDifferenceSteps(const QVector<double>& steps)
+{
+    m_steps = steps;
+}
+
+void MultiStartSearch::samplingRange(int j, double x0, double& low, double& high) const
+{
+    double lower = (j < m_lower.size() && std::isfinite(m_lower[j])) ? m_lower[j] : -std::numeric_limits<double>::infinity();
+    double upper = (j < m_upper.size() && std::isfinite(m_upper[j])) ? m_upper[j] : std::numeric_limits<double>::infinity();
+    low = std::isfinite(lower) ? lower : std::min(x0, upper) - m_config.unboundedSpan;
+    high = std::isfinite(upper) ? upper : std::max(x0, lower) + m_config.unboundedSpan;
+}
+
+QVector<QVector<double>> MultiStartSearch::startingPoints(const QVector<double>& x0) const
+{
+    const int n = x0.size();
+    const int count = std::max(1, m_config.startCount);
+    QVector<QVector<double>> points(count, x0);
+    if (count == 1) return points;
+
+    // 第一个起点保留 x0，其余 count - 1 个起点构成拉丁超立方
+    const int strata = count - 1;
+    std::mt19937 rng(m_config.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<int> order(strata);
+    for (int j = 0; j < n; ++j) {
+        double low, high;
+        samplingRange(j, x0[j], low, high);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), rng);
+        for (int k = 0; k < strata; ++k) {
+            double u = (order[k] + unit(rng)) / strata;
+            points[k + 1][j] = low + u * (high - low);
+        }
+    }
+    return points;
+}
+
+MultiStartResult MultiStartSearch::run(const LevenbergMarquardtSolver::ResidualFunction& residuals, const QVector<double>& x0) const
+{
+    MultiStartResult result;
+    result.x = x0;
+    result.meanSquare = std::numeric_limits<double>::infinity();
+    const int n = x0.size();
+
+    // 与雅可比差分列相同的规则: 同时运行的求解数不少于线程数时线程池已被占满，
+    // 差分列 (concurrentJacobian = false) 与单条曲线都不再并行；否则沿用 localConfig 与调用方的并发设置
+    const int threadCount = QThreadPool::globalInstance()->maxThreadCount();
+    LevenbergMarquardtSolver::ResidualFunction serial = [&residuals](const QVector<double>& x, bool) {
+        return residuals(x, true);
+    };
+    auto phaseConfig = [&](LevenbergMarquardtConfig config, int runCount) {
+        if (runCount >= threadCount) config.concurrentJacobian = false;
+        return config;
+    };
+    auto phaseResiduals = [&](int runCount) { return runCount >= threadCount ? serial : residuals; };
+
+    struct Run {
+        QVector<double> x;
+        FitStatistics stats;
+        bool valid;
+
+        Run() : valid(false) {}
+    };
+
+    QMutex mutex;
+    std::atomic<int> done(0);
+    int improvements = 0; // 以下三项均由 mutex 保护
+    int notified = 0;
+    bool notifying = false;
+    const QVector<QVector<double>> starts = startingPoints(x0);
+    const int refineCount = std::max(0, std::min(m_config.refineCount, int(starts.size())));
+    const int total = starts.size() + refineCount;
+
+    auto stopped = [this]() { return m_stopCallback && m_stopCallback(); };
+    auto offer = [&](const QVector<double>& x, double meanSquare) {
+        QMutexLocker locker(&mutex);
+        if (meanSquare >= result.meanSquare) return;
+        result.x = x;
+        result.meanSquare = meanSquare;
+        ++improvements;
+        if (!m_improvementCallback || notifying) return;
+
+        // 回调可能耗时 (如重算并绘制曲线)，在锁外调用，不阻塞其他起点更新最优点
+        notifying = true;
+        while (notified != improvements) {
+            notified = improvements;
+            const QVector<double> bestX = result.x;
+            const double bestMeanSquare = result.meanSquare;
+            locker.unlock();
+            m_improvementCallback(bestX, bestMeanSquare);
+            locker.relock();
+        }
+        notifying = false;
+    };
+    auto solve = [&](const LevenbergMarquardtConfig& config, const LevenbergMarquardtSolver::ResidualFunction& function,
+                     const QVector<double>& start, bool reportSteps) {
+        Run run;
+        run.x = start;
+        LevenbergMarquardtSolver solver(config);
+        solver.setBounds(m_lower, m_upper);
+        solver.setDifferenceSteps(m_steps);
+        solver.setStopCallback(stopped);
+        if (reportSteps) {
+            solver.setIterationCallback([&](int, const QVector<double>& x, double meanSquare) { offer(x, meanSquare); });
+        }
+        run.stats = solver.minimize(function, run.x);
+        run.valid = (run.stats.termination != FitTermination::EvaluationFailed);
+        if (run.valid) offer(run.x, run.stats.finalError);
+        if (m_progressCallback) m_progressCallback(++done, total);
+        return run;
+    };
+
+    // 1. 各起点的短 LM
+    LevenbergMarquardtConfig shortConfig = phaseConfig(m_localConfig, starts.size());
+    shortConfig.maxIterations = std::max(1, m_config.localIterations);
+    const LevenbergMarquardtSolver::ResidualFunction shortResiduals = phaseResiduals(starts.size());
+    QVector<Run> runs(starts.size());
+    QVector<int> indices(starts.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](int k) {
+        if (stopped()) return;
+        runs[k] = solve(shortConfig, shortResiduals, starts[k], false);
+    });
+
+    FitStatistics& stats = result.statistics;
+    const Run* winner = nullptr;
+    auto accumulate = [&](const Run& run) {
+        stats.iterations += run.stats.iterations;
+        stats.acceptedSteps += run.stats.acceptedSteps;
+        stats.residualEvaluations += run.stats.residualEvaluations;
+        stats.jacobianEvaluations += run.stats.jacobianEvaluations;
+        stats.broydenUpdates += run.stats.broydenUpdates;
+        if (run.valid && (!winner || run.stats.finalError < winner->stats.finalError)) winner = &run;
+    };
+    for (const Run& run : runs) {
+        if (run.x.isEmpty()) continue; // 停止请求后未运行的起点
+        result.startsCompleted++;
+        accumulate(run);
+    }
+    if (!runs.isEmpty() && runs[0].valid) stats.initialError = runs[0].stats.initialError;
+
+    // 2. 选出互不重合的最优若干个结果 (按归一化坐标比较)
+    QVector<int> ranked;
+    for (int k = 0; k < runs.size(); ++k) if (runs[k].valid) ranked.append(k);
+    std::sort(ranked.begin(), ranked.end(), [&](int a, int b) { return runs[a].stats.finalError < runs[b].stats.finalError; });
+    QVector<double> span(n);
+    for (int j = 0; j < n; ++j) {
+        double low, high;
+        samplingRange(j, x0[j], low, high);
+        span[j] = std::max(high - low, 1e-12);
+    }
+    QVector<int> chosen;
+    for (int k : ranked) {
+        if (chosen.size() >= refineCount) break;
+        bool distinct = true;
+        for (int c : chosen) {
+            double distance = 0.0;
+            for (int j = 0; j < n; ++j) distance = std::max(distance, std::abs(runs[k].x[j] - runs[c].x[j]) / span[j]);
+            if (distance < m_config.distinctDistance) { distinct = false; break; }
+        }
+        if (distinct) chosen.append(k);
+    }
+
+    // 3. 以完整配置精细化 (默认只有 3 个，求解器内部的差分列与曲线并发补足空闲线程)
+    const LevenbergMarquardtConfig refineConfig = phaseConfig(m_localConfig, chosen.size());
+    const LevenbergMarquardtSolver::ResidualFunction refineResiduals = phaseResiduals(chosen.size());
+    QVector<Run> refined(chosen.size());
+    QVector<int> refineIndices(chosen.size());
+    std::iota(refineIndices.begin(), refineIndices.end(), 0);
+    QtConcurrent::blockingMap(refineIndices, [&](int k) {
+        if (stopped()) return;
+        refined[k] = solve(refineConfig, refineResiduals, runs[chosen[k]].x, true);
+    });
+    for (const Run& run : refined) {
+        if (run.x.isEmpty()) continue;
+        result.refinements++;
+        accumulate(run);
+    }
+
+    if (winner) {
+        stats.finalError = winner->stats.finalError;
+        stats.errorHistory = winner->stats.errorHistory;
+        stats.termination = winner->stats.termination;
+    } else {
+        stats.termination = FitTermination::EvaluationFailed;
+    }
+    if (stopped()) stats.termination = FitTermination::Stopped;
+    if (m_progressCallback) m_progressCallback(total, total);
+    return result;
+}
@@ -0,0 +1,87 @@
+/*
+ * multistartsearch.h
+ * 文件作用：多起点全局搜索 (拉丁超立方采样 + 短 LM + 精细化) 头文件
+ * 功能描述：
+ * 1. 与界面无关，与 LevenbergMarquardtSolver 共用残差回调与求解变量空间 (对数参数已取 log10)
+ * 2. 在各变量的上下界内按拉丁超立方抽取起点 (调用方给出的初始点作为第一个起点)
+ * 3. 各起点的短 LM 拟合整批分发到全局线程池并发运行；同时运行的求解数不少于线程数时，每个 LM 的差分列
+ *    与单条曲线内部都不再并行，精细化等求解数较少的阶段保留求解器内部的并发
+ * 4. 从互不重合的最优若干个结果出发，以完整配置的 LM 精细化，取其中最优者
+ */
+
+#ifndef MULTISTARTSEARCH_H
+#define MULTISTARTSEARCH_H
+
+#include "levenbergmarquardt.h"
+
+// 搜索配置
+struct MultiStartConfig {
+    int startCount;          // 起点个数 (含初始点)
+    int localIterations;     // 每个起点短 LM 的最大试探次数
+    int refineCount;         // 进入精细化的最优结果个数
+    double distinctDistance; // 归一化坐标 (除以边界跨度) 的最大分量差小于该值的结果视为同一极小点
+    double unboundedSpan;    // 某侧无界的变量在初始值两侧各取该跨度作为采样范围
+    unsigned int seed;       // 随机数种子 (相同种子得到相同的起点)
+
+    MultiStartConfig() :
+        startCount(32),
+        localIterations(15),
+        refineCount(3),
+        distinctDistance(0.05),
+        unboundedSpan(1.0),
+        seed(20241227u)
+    {}
+};
+
+// 搜索结果
+struct MultiStartResult {
+    QVector<double> x;          // 最优点
+    double meanSquare;          // 最优点的均方误差
+    int startsCompleted;        // 完成的短 LM 起点个数
+    int refinements;            // 完成的精细化次数
+    // 累计统计: 各次数为所有短 LM 与精细化之和，initialError 为初始点的误差，
+    // finalError、errorHistory 与 termination 取自最优结果所在的那次求解
+    FitStatistics statistics;
+
+    MultiStartResult() : meanSquare(0.0), startsCompleted(0), refinements(0) {}
+};
+
+class MultiStartSearch
+{
+public:
+    // 进度回调: 已完成的求解次数 / 总次数 (短 LM 与精细化合计)
+    typedef std::function<void(int done, int total)> ProgressCallback;
+    // 找到新的全局最优点时回调 (可能来自任一工作线程，但调用之间不重叠，误差严格递减，最后一次为全局最优)
+    typedef std::function<void(const QVector<double>& x, double meanSquare)> ImprovementCallback;
+
+    // localConfig 为精细化使用的 LM 配置，短 LM 在其基础上把最大试探次数改为 localIterations
+    MultiStartSearch(const MultiStartConfig& config, const LevenbergMarquardtConfig& localConfig);
+
+    // 参数上下界与差分步长 (含义与 LevenbergMarquardtSolver 相同)
+    void setBounds(const QVector<double>& lower, const QVector<double>& upper);
+    void setDifferenceSteps(const QVector<double>& steps);
+    void setProgressCallback(const ProgressCallback& callback) { m_progressCallback = callback; }
+    void setImprovementCallback(const ImprovementCallback& callback) { m_improvementCallback = callback; }
+    void setStopCallback(const LevenbergMarquardtSolver::StopCallback& callback) { m_stopCallback = callback; }
+
+    // 拉丁超立方起点 (第一个为 x0)，供调用方检查或复用
+    QVector<QVector<double>> startingPoints(const QVector<double>& x0) const;
+
+    // 从 x0 及拉丁超立方起点出发搜索，停止时返回已找到的最优点
+    MultiStartResult run(const LevenbergMarquardtSolver::ResidualFunction& residuals, const QVector<double>& x0) const;
+
+private:
+    MultiStartConfig m_config;
+    LevenbergMarquardtConfig m_localConfig;
+    QVector<double> m_lower;
+    QVector<double> m_upper;
+    QVector<double> m_steps;
+    ProgressCallback m_progressCallback;
+    ImprovementCallback m_improvementCallback;
+    LevenbergMarquardtSolver::StopCallback m_stopCallback;
+
+    // 变量 j 的采样范围
+    void samplingRange(int j, double x0, double& low, double& high) const;
+};
+
+#endif // MULTISTARTSEARCH_H
@@ -0,0 +1,114 @@
+/*
+ * toeplitzsolver.cpp
+ * 文件作用：对称 Toeplitz 线性方程组求解工具实现
+ * 功能描述：
+ * 1. 先将 T 按对角元 r[0] 归一化，再同时递推 Yule-Walker 解 y 与原方程解 x
+ * 2. y、x 均原地更新，工作区只需存放 y、残差与修正量
+ * 3. Levinson 只要求顺序主子式非奇异，对非正定矩阵可能损失精度，
+ *    因此以修正后的残差作为是否可信的最终判据
+ */
+
+#include "toeplitzsolver.h"
+
+#include <cmath>
+#include <complex>
+#include <algorithm>
+
+namespace {
+
+inline bool isFiniteValue(double v) { return std::isfinite(v); }
+inline bool isFiniteValue(const std::complex<double>& v) { return std::isfinite(v.real()) && std::isfinite(v.imag()); }
+
+} // namespace
+
+template <typename T>
+bool ToeplitzSolver::solveSymmetric(int n, const T* r, const T* b, T* x, T* work,
+                                    double tolerance)
+{
+    if (n <= 0) return true;
+
+    T* y = work;
+    T* res = work + n;
+    T* dx = work + 2 * n;
+
+    if (!levinson(n, r, b, x, y)) return false;
+
+    double bNorm = 0.0;
+    for (int i = 0; i < n; ++i) bNorm = std::max(bNorm, std::abs(b[i]));
+    if (bNorm == 0.0) return true;
+
+    // 一次迭代修正：T dx = b - T x，x += dx
+    residual(n, r, b, x, res);
+    if (!levinson(n, r, res, dx, y)) return false;
+    for (int i = 0; i < n; ++i) x[i] += dx[i];
+
+    double resNorm = residual(n, r, b, x, res);
+    return resNorm <= tolerance * bNorm;
+}
+
+template <typename T>
+bool ToeplitzSolver::levinson(int n, const T* r, const T* b, T* x, T* y)
+{
+    T r0 = r[0];
+    if (r0 == 0.0 || !isFiniteValue(r0)) return false;
+
+    const T invR0 = 1.0 / r0;
+    // beta 为相邻两阶归一化主子式之比，过小说明递推已失稳
+    const double minBeta = 1e-13;
+
+    x[0] = b[0] * invR0;
+    if (n == 1) return isFiniteValue(x[0]);
+
+    T alpha = -r[1] * invR0;
+    T beta = 1.0;
+    y[0] = alpha;
+
+    for (int k = 1; k < n; ++k) {
+        beta *= (1.0 - alpha * alpha);
+        if (!(std::abs(beta) > minBeta)) return false;
+
+        // mu = (b[k] - r[1..k] · x[k-1..0]) / beta
+        T s = b[k] * invR0;
+        for (int i = 0; i < k; ++i) s -= r[i + 1] * invR0 * x[k - 1 - i];
+        T mu = s / beta;
+        for (int i = 0; i < k; ++i) x[i] += mu * y[k - 1 - i];
+        x[k] = mu;
+
+        if (k < n - 1) {
+            // alpha = (-r[k+1] - r[1..k] · y[k-1..0]) / beta
+            T a = -r[k + 1] * invR0;
+            for (int i = 0; i < k; ++i) a -= r[i + 1] * invR0 * y[k - 1 - i];
+            alpha = a / beta;
+            // y[i] += alpha * y[k-1-i]，成对更新以便原地进行
+            for (int i = 0, j = k - 1; i <= j; ++i, --j) {
+                T yi = y[i], yj = y[j];
+                y[i] = yi + alpha * yj;
+                if (i != j) y[j] = yj + alpha * yi;
+            }
+            y[k] = alpha;
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (!isFiniteValue(x[i])) return false;
+    }
+    return true;
+}
+
+template <typename T>
+double ToeplitzSolver::residual(int n, const T* r, const T* b, const T* x, T* res)
+{
+    double maxRes = 0.0;
+    for (int i = 0; i < n; ++i) {
+        T s = b[i];
+        for (int j = 0; j < n; ++j) s -= r[std::abs(i - j)] * x[j];
+        res[i] = s;
+        maxRes = std::max(maxRes, std::abs(s));
+    }
+    return maxRes;
+}
+
+// 显式实例化: 实数 (Stehfest) 与复数 (Talbot / de Hoog / Euler) 两种求值路径
+template bool ToeplitzSolver::solveSymmetric<double>(int, const double*, const double*, double*, double*, double);
+template bool ToeplitzSolver::solveSymmetric<std::complex<double>>(int, const std::complex<double>*, const std::complex<double>*,
+                                                                   std::complex<double>*, std::complex<double>*, double);
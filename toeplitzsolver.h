@@ -0,0 +1,37 @@
+/*
+ * toeplitzsolver.h
+ * 文件作用：对称 Toeplitz 线性方程组求解工具头文件
+ * 功能描述：
+ * 1. 使用 Levinson 递推 (Golub & Van Loan, Alg. 4.7.2) 以 O(n^2) 求解 T x = b
+ * 2. 不做任何内存分配，工作区由调用方提供 (可直接使用栈上数组)
+ * 3. 求解后做一次迭代修正并校验残差；顺序主子式接近奇异导致递推失稳时返回 false，
+ *    由调用方退回到通用 LU 分解
+ * 4. 标量类型 T 支持 double 与 std::complex<double> (复数对称阵，非 Hermite 阵)
+ */
+
+#ifndef TOEPLITZSOLVER_H
+#define TOEPLITZSOLVER_H
+
+class ToeplitzSolver
+{
+public:
+    // solveSymmetric 所需工作区长度 (以 double 计)
+    static int workSize(int n) { return 3 * n; }
+
+    // 求解对称 Toeplitz 方程组 T x = b，T(i, j) = r[|i - j|]
+    // r, b, x 长度均为 n，x 不能与 b 重叠；work 长度不小于 workSize(n)
+    // 成功返回 true；递推失稳或修正后残差仍超过 tolerance * max|b| 时返回 false
+    template <typename T>
+    static bool solveSymmetric(int n, const T* r, const T* b, T* x, T* work,
+                               double tolerance = 1e-12);
+
+private:
+    // Levinson 递推本体，y 为长度 n 的 Yule-Walker 工作区
+    template <typename T>
+    static bool levinson(int n, const T* r, const T* b, T* x, T* y);
+    // 计算残差 res = b - T x，返回 max|res|
+    template <typename T>
+    static double residual(int n, const T* r, const T* b, const T* x, T* res);
+};
+
+#endif // TOEPLITZSOLVER_H
@@ -18,6 +18,7 @@
 #include <QMessageBox>
 #include <QDebug>
 #include <cmath>
+#include <limits>
 #include <QFileDialog>
 #include <QFile>
 #include <QTextStream>
@@ -32,7 +33,6 @@
 #include <QJsonArray>
 #include <QDateTime>
 #include <QBuffer>
-#include <Eigen/Dense>
 
 // ===========================================================================
 // FittingWidget 实现
@@ -44,7 +44,9 @@ FittingWidget::FittingWidget(QWidget *parent) :
     m_modelManager(nullptr),
     m_plotTitle(nullptr),
     m_currentModelType(ModelManager::Model_1),
-    m_isFitting(false)
+    m_fitMethod(FitMethod::LevenbergMarquardt),
+    m_isFitting(false),
+    m_stopRequested(false)
 {
     ui->setupUi(this);
 
@@ -52,6 +54,10 @@ FittingWidget::FittingWidget(QWidget *parent) :
     ui->splitter->setSizes(QList<int>{380, 720});
     ui->splitter->setCollapsible(0, false);
 
+    // 均方误差 (对数残差) 低于 3e-3 时拟合已足够好，不再继续迭代
+    m_solverConfig.targetMeanSquare = 3e-3;
+    m_evolutionConfig.targetMeanSquare = 3e-3;
+
     // --- 初始化参数管理模块 ---
     m_paramChart = new FittingParameterChart(ui->tableParams, this);
 
@@ -81,6 +87,12 @@ FittingWidget::FittingWidget(QWidget *parent) :
     ui->sliderWeight->setRange(0, 100);
     ui->sliderWeight->setValue(50);
     onSliderWeightChanged(50);
+
+    // --- 拟合方法 ---
+    ui->comboFitMethod->addItem("局部拟合 (LM)");
+    ui->comboFitMethod->addItem("全局搜索 (多起点 LM)");
+    ui->comboFitMethod->addItem("全局搜索 (差分进化)");
+    connect(ui->comboFitMethod, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FittingWidget::onFitMethodChanged);
 }
 
 FittingWidget::~FittingWidget() { delete ui; }
@@ -109,6 +121,15 @@ void FittingWidget::onSliderWeightChanged(int value) {
     ui->label_ValPressure->setText(QString("压力权重: %1").arg(wPressure, 0, 'f', 2));
 }
 
+void FittingWidget::onFitMethodChanged(int index) {
+    m_fitMethod = (FitMethod)qMax(0, index);
+}
+
+void FittingWidget::setFitMethod(FitMethod method) {
+    m_fitMethod = method;
+    ui->comboFitMethod->setCurrentIndex((int)method);
+}
+
 // 参数选择按钮槽函数 (Qt 自动连接)
 void FittingWidget::on_btnSelectParams_clicked()
 {
@@ -133,6 +154,7 @@ QJsonObject FittingWidget::getJsonState() const
     root["modelType"] = (int)m_currentModelType;
     root["modelName"] = ModelManager::getModelTypeName(m_currentModelType);
     root["fitWeightVal"] = ui->sliderWeight->value();
+    root["fitMethod"] = (int)m_fitMethod;
 
     QJsonObject plotRange;
     plotRange["xMin"] = m_plot->xAxis->range().lower;
@@ -218,6 +240,11 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         ui->sliderWeight->setValue((int)(w * 100));
     }
 
+    if (root.contains("fitMethod")) {
+        int method = root["fitMethod"].toInt();
+        if (method >= 0 && method < ui->comboFitMethod->count()) setFitMethod((FitMethod)method);
+    }
+
     if (root.contains("observedData")) {
         QJsonObject obs = root["observedData"].toObject();
         QJsonArray tArr = obs["time"].toArray();
@@ -447,6 +474,22 @@ void FittingWidget::setObservedData(const QVector<double>& t, const QVector<doub
     m_plot->replot();
 }
 
+void FittingWidget::setRateHistory(const RateHistory& history) {
+    m_rateHistory = history;
+}
+
+void FittingWidget::setJacobianStrategy(JacobianStrategy strategy, int refreshInterval) {
+    m_solverConfig.jacobian = strategy;
+    m_solverConfig.broydenRefreshInterval = qMax(1, refreshInterval);
+}
+
+ModelCurveData FittingWidget::calculateModelCurve(ModelManager::ModelType modelType, const QMap<QString, double>& params, const RateHistory& history,
+                                                  const QVector<double>& time, const ModelEvaluationConfig& config) const {
+    if(history.isMultiRate())
+        return m_modelManager->calculateSuperposedCurve(modelType, CompositeModelParameters::fromMap(params), history, time, config);
+    return m_modelManager->calculateTheoreticalCurve(modelType, params, time, config);
+}
+
 void FittingWidget::on_btnResetView_clicked() {
     if(m_plot->graph(0)->dataCount() > 0) {
         m_plot->rescaleAxes();
@@ -477,17 +520,29 @@ void FittingWidget::on_btnRunFit_clicked() {
     if(m_obsTime.isEmpty()) { QMessageBox::warning(this,"错误","请先加载观测数据。"); return; }
 
     m_paramChart->updateParamsFromTable();
-    m_isFitting = true; m_stopRequested = false; ui->btnRunFit->setEnabled(false);
+    m_isFitting = true; m_stopRequested = false; ui->btnRunFit->setEnabled(false); ui->comboFitMethod->setEnabled(false);
 
     ModelManager::ModelType modelType = m_currentModelType;
     QList<FitParameter> paramsCopy = m_paramChart->getParameters();
 
+    // 拟合方法、产量历史与优化器配置按值传入工作线程
+    FitSettings settings;
+    settings.method = m_fitMethod;
+    settings.rateHistory = m_rateHistory;
+    settings.solverConfig = m_solverConfig;
+    settings.multiStartConfig = m_multiStartConfig;
+    settings.evolutionConfig = m_evolutionConfig;
+
     double w = ui->sliderWeight->value() / 100.0;
-    (void)QtConcurrent::run([this, modelType, paramsCopy, w](){ runOptimizationTask(modelType, paramsCopy, w); });
+    (void)QtConcurrent::run([this, modelType, paramsCopy, w, settings](){ runOptimizationTask(modelType, paramsCopy, w, settings); });
 }
 
-void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight) {
-    runLevenbergMarquardtOptimization(modelType, fitParams, weight);
+void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, const FitSettings& settings) {
+    switch(settings.method) {
+    case FitMethod::MultiStart: runMultiStartOptimization(modelType, fitParams, weight, settings); break;
+    case FitMethod::DifferentialEvolution: runDifferentialEvolutionOptimization(modelType, fitParams, weight, settings); break;
+    default: runLevenbergMarquardtOptimization(modelType, fitParams, weight, settings); break;
+    }
 }
 
 void FittingWidget::on_btnStop_clicked() { m_stopRequested=true; }
@@ -566,99 +621,169 @@ void FittingWidget::updateModelCurve() {
     QVector<double> targetT = m_obsTime;
     if(targetT.isEmpty()) { for(double e = -4; e <= 4; e += 0.1) targetT.append(pow(10, e)); }
 
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, currentParams, targetT);
+    ModelCurveData res = calculateModelCurve(type, currentParams, m_rateHistory, targetT);
     onIterationUpdate(0, currentParams, std::get<0>(res), std::get<1>(res), std::get<2>(res));
 }
 
-void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight) {
-    if(m_modelManager) m_modelManager->setHighPrecision(false);
+FitVariables FitVariables::fromParameters(const QList<FitParameter>& params) {
+    FitVariables vars;
+    for(const auto& p : params) vars.paramMap.insert(p.name, p.value);
+    if(vars.paramMap.contains("L") && vars.paramMap.contains("Lf") && vars.paramMap["L"] > 1e-9)
+        vars.paramMap["LfD"] = vars.paramMap["Lf"] / vars.paramMap["L"];
+    vars.base = CompositeModelParameters::fromMap(vars.paramMap);
+
+    const double inf = std::numeric_limits<double>::infinity();
+    for(const FitParameter& p : params) {
+        if(!p.isFit) continue;
+        double val = vars.paramMap.value(p.name);
+        CompositeModelParameters probe = vars.base;
+        if(!probe.setValue(p.name, val)) continue; // 模型不使用的参数不参与求解
+        bool logScale = (val > 1e-12 && p.name != "S" && p.name != "nf");
+        vars.names.append(p.name); vars.isLog.append(logScale);
+        if(logScale) {
+            vars.x.append(log10(val)); vars.steps.append(0.01);
+            vars.lower.append(p.min > 0.0 ? log10(p.min) : -inf);
+            vars.upper.append(p.max > 0.0 ? log10(p.max) : inf);
+        } else {
+            vars.x.append(val); vars.steps.append(1e-4);
+            vars.lower.append(p.min); vars.upper.append(p.max);
+        }
+    }
+    return vars;
+}
 
-    QVector<int> fitIndices;
-    for(int i=0; i<params.size(); ++i) if(params[i].isFit) fitIndices.append(i);
-    int nParams = fitIndices.size();
-    if(nParams == 0) { QMetaObject::invokeMethod(this, "onFitFinished"); return; }
+CompositeModelParameters FitVariables::toParams(const QVector<double>& v) const {
+    CompositeModelParameters p = base;
+    for(int k = 0; k < names.size(); ++k) p.setValue(names[k], isLog[k] ? pow(10.0, v[k]) : v[k]);
+    return p;
+}
 
-    double lambda = 0.01; int maxIter = 50; double currentSSE = 1e15;
-    QMap<QString, double> currentParamMap;
-    for(const auto& p : params) currentParamMap.insert(p.name, p.value);
+QMap<QString, double> FitVariables::toParamMap(const QVector<double>& v) const {
+    QMap<QString, double> map = paramMap;
+    for(int k = 0; k < names.size(); ++k) map[names[k]] = isLog[k] ? pow(10.0, v[k]) : v[k];
+    if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9) map["LfD"] = map["Lf"] / map["L"];
+    return map;
+}
 
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
+ModelEvaluationConfig FittingWidget::fitEvaluationConfig(bool parallelModel) {
+    // 拟合过程中使用低精度反演 (精度作为参数传入计算引擎，不再修改共享的模型状态)
+    ModelEvaluationConfig config;
+    config.parallel = parallelModel;
+    config.highPrecision = false;
+    config.sampleMergeTolerance = 1e-14; // 实测时间等间隔时，合并仅因舍入而不同的反演节点
+    config.adaptiveTimeGrid = true;      // 计算量与实测数据采样密度无关 (插值误差 < 1e-4)
+    return config;
+}
 
-    QVector<double> residuals = calculateResiduals(currentParamMap, modelType, weight);
-    currentSSE = calculateSumSquaredError(residuals);
-    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings) {
+    const ModelEvaluationConfig fitConfig = fitEvaluationConfig();
+
+    const FitVariables vars = FitVariables::fromParameters(params);
+    if(vars.names.isEmpty()) { QMetaObject::invokeMethod(this, "onFitFinished"); return; }
+
+    LevenbergMarquardtSolver solver(settings.solverConfig);
+    solver.setBounds(vars.lower, vars.upper);
+    solver.setDifferenceSteps(vars.steps);
+    solver.setStopCallback([this]() { return m_stopRequested.load(); });
+    solver.setIterationCallback([&](int iteration, const QVector<double>& v, double meanSquare) {
+        emit sigProgress(qMin(99, iteration * 100 / qMax(1, settings.solverConfig.maxIterations)));
+        QMap<QString, double> map = vars.toParamMap(v);
+        ModelCurveData curve = calculateModelCurve(modelType, map, settings.rateHistory, QVector<double>(), fitConfig);
+        emit sigIterationUpdated(meanSquare, map, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    });
+
+    // 雅可比差分列由求解器并发求值，已占满线程池时单条曲线内部不再并行
+    QVector<double> x = vars.x;
+    const FitStatistics stats = solver.minimize([&](const QVector<double>& v, bool concurrent) {
+        return calculateResiduals(vars.toParams(v), modelType, weight, settings.rateHistory, !concurrent);
+    }, x);
+    finishOptimization(modelType, vars.toParamMap(x), settings.rateHistory, stats, "LM");
+}
 
-    for(int iter = 0; iter < maxIter; ++iter) {
-        if(m_stopRequested) break;
-        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) break;
+void FittingWidget::runMultiStartOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings) {
+    const ModelEvaluationConfig fitConfig = fitEvaluationConfig();
+
+    const FitVariables vars = FitVariables::fromParameters(params);
+    if(vars.names.isEmpty()) { QMetaObject::invokeMethod(this, "onFitFinished"); return; }
+
+    // 起点在各参数表上下界内采样 (log 变量即在对数尺度上均匀)，以当前表中的值作为第一个起点
+    MultiStartSearch search(settings.multiStartConfig, settings.solverConfig);
+    search.setBounds(vars.lower, vars.upper);
+    search.setDifferenceSteps(vars.steps);
+    search.setStopCallback([this]() { return m_stopRequested.load(); });
+    search.setProgressCallback([this](int done, int total) { emit sigProgress(qMin(99, done * 100 / qMax(1, total))); });
+    search.setImprovementCallback([&](const QVector<double>& v, double meanSquare) {
+        QMap<QString, double> map = vars.toParamMap(v);
+        ModelCurveData curve = calculateModelCurve(modelType, map, settings.rateHistory, QVector<double>(), fitConfig);
+        emit sigIterationUpdated(meanSquare, map, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    });
+
+    MultiStartResult result = search.run([&](const QVector<double>& v, bool concurrent) {
+        return calculateResiduals(vars.toParams(v), modelType, weight, settings.rateHistory, !concurrent);
+    }, vars.x);
+    qDebug() << "多起点搜索: 完成起点" << result.startsCompleted << "精细化" << result.refinements;
+    finishOptimization(modelType, vars.toParamMap(result.x), settings.rateHistory, result.statistics, "多起点");
+}
 
-        emit sigProgress(iter * 100 / maxIter);
-        QVector<QVector<double>> J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight);
-        int nRes = residuals.size();
+void FittingWidget::runDifferentialEvolutionOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings) {
+    const ModelEvaluationConfig fitConfig = fitEvaluationConfig();
+
+    const FitVariables vars = FitVariables::fromParameters(params);
+    if(vars.names.isEmpty()) { QMetaObject::invokeMethod(this, "onFitFinished"); return; }
+
+    // 种群在参数表上下界内采样，越界分量由优化器拉回界内；只在最优误差下降时刷新曲线
+    DifferentialEvolution evolution(settings.evolutionConfig);
+    evolution.setBounds(vars.lower, vars.upper);
+    evolution.setStopCallback([this]() { return m_stopRequested.load(); });
+    double lastBest = std::numeric_limits<double>::infinity();
+    evolution.setGenerationCallback([&](int generation, const QVector<double>& v, double meanSquare) {
+        emit sigProgress(qMin(99, generation * 100 / qMax(1, settings.evolutionConfig.maxGenerations)));
+        if(meanSquare >= lastBest) return;
+        lastBest = meanSquare;
+        QMap<QString, double> map = vars.toParamMap(v);
+        ModelCurveData curve = calculateModelCurve(modelType, map, settings.rateHistory, QVector<double>(), fitConfig);
+        emit sigIterationUpdated(meanSquare, map, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    });
+
+    // 残差与 LM 相同 (calculateResiduals)，种群并发求值时单条曲线内部不再并行
+    QVector<double> x = vars.x;
+    const FitStatistics stats = evolution.minimize([&](const QVector<double>& v, bool concurrent) {
+        return calculateResiduals(vars.toParams(v), modelType, weight, settings.rateHistory, !concurrent);
+    }, x);
+    finishOptimization(modelType, vars.toParamMap(x), settings.rateHistory, stats, "差分进化");
+}
 
-        QVector<QVector<double>> H(nParams, QVector<double>(nParams, 0.0));
-        QVector<double> g(nParams, 0.0);
-        for(int k=0; k<nRes; ++k) {
-            for(int i=0; i<nParams; ++i) {
-                g[i] += J[k][i] * residuals[k];
-                for(int j=0; j<=i; ++j) H[i][j] += J[k][i] * J[k][j];
-            }
-        }
-        for(int i=0; i<nParams; ++i) for(int j=i+1; j<nParams; ++j) H[i][j] = H[j][i];
-
-        bool stepAccepted = false;
-        for(int tryIter=0; tryIter<5; ++tryIter) {
-            QVector<QVector<double>> H_lm = H;
-            for(int i=0; i<nParams; ++i) H_lm[i][i] += lambda * (1.0 + std::abs(H[i][i]));
-            QVector<double> negG(nParams); for(int i=0;i<nParams;++i) negG[i] = -g[i];
-            QVector<double> delta = solveLinearSystem(H_lm, negG);
-
-            QMap<QString, double> trialMap = currentParamMap;
-            for(int i=0; i<nParams; ++i) {
-                int pIdx = fitIndices[i];
-                QString pName = params[pIdx].name;
-                double oldVal = currentParamMap[pName];
-                bool isLog = (oldVal > 1e-12 && pName != "S" && pName != "nf");
-                double newVal;
-                if(isLog) {
-                    double logVal = log10(oldVal) + delta[i];
-                    newVal = pow(10.0, logVal);
-                } else {
-                    newVal = oldVal + delta[i];
-                }
-                newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
-                trialMap[pName] = newVal;
-            }
-            if(trialMap.contains("L") && trialMap.contains("Lf") && trialMap["L"] > 1e-9) trialMap["LfD"] = trialMap["Lf"] / trialMap["L"];
-
-            QVector<double> newRes = calculateResiduals(trialMap, modelType, weight);
-            double newSSE = calculateSumSquaredError(newRes);
-            if(newSSE < currentSSE) {
-                currentSSE = newSSE; currentParamMap = trialMap; residuals = newRes; lambda /= 10.0; stepAccepted = true;
-                ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-                emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
-                break;
-            } else { lambda *= 10.0; }
-        }
-        if(!stepAccepted && lambda > 1e10) break;
-    }
+void FittingWidget::finishOptimization(ModelManager::ModelType modelType, const QMap<QString, double>& params, const RateHistory& history,
+                                       const FitStatistics& stats, const char* label) {
+    qDebug() << label << "拟合统计: 终止原因" << (int)stats.termination << "试探" << stats.iterations << "接受" << stats.acceptedSteps
+             << "残差求值" << stats.residualEvaluations << "差分雅可比" << stats.jacobianEvaluations
+             << "割线更新" << stats.broydenUpdates << "误差" << stats.initialError << "->" << stats.finalError;
+
+    ModelCurveData finalCurve = calculateModelCurve(modelType, params, history, QVector<double>());
+    emit sigIterationUpdated(stats.finalError, params, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+    // 统计随结束通知排队交给界面线程写入，lastFitStatistics() 只在界面线程读取
+    QMetaObject::invokeMethod(this, [this, stats]() {
+        m_lastFitStatistics = stats;
+        onFitFinished();
+    }, Qt::QueuedConnection);
+}
 
-    if(m_modelManager) m_modelManager->setHighPrecision(true);
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
-    QMetaObject::invokeMethod(this, "onFitFinished");
+QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight,
+                                                  const RateHistory& history) {
+    return calculateResiduals(CompositeModelParameters::fromMap(params), modelType, weight, history);
 }
 
-QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) {
+QVector<double> FittingWidget::calculateResiduals(const CompositeModelParameters& params, ModelManager::ModelType modelType, double weight,
+                                                  const RateHistory& history, bool parallelModel) {
     if(!m_modelManager || m_obsTime.isEmpty()) return QVector<double>();
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, params, m_obsTime);
-    const QVector<double>& pCal = std::get<1>(res); const QVector<double>& dpCal = std::get<2>(res);
+    const ModelEvaluationConfig fitConfig = fitEvaluationConfig(parallelModel);
+    // 曲线缓冲区按线程复用: 实测时间点不变，重复求值时不再分配
+    thread_local QVector<double> pCal, dpCal;
+    if(history.isMultiRate()) m_modelManager->calculateSuperposedCurve(modelType, params, history, m_obsTime, fitConfig, pCal, dpCal);
+    else m_modelManager->calculateTheoreticalCurve(modelType, params, m_obsTime, fitConfig, pCal, dpCal);
     QVector<double> r; double wp = weight; double wd = 1.0 - weight;
     int count = qMin(m_obsPressure.size(), pCal.size());
+    r.reserve(count + qMin(m_obsDerivative.size(), count));
     for(int i=0; i<count; ++i) {
         if(m_obsPressure[i] > 1e-10 && pCal[i] > 1e-10) r.append( (log(m_obsPressure[i]) - log(pCal[i])) * wp ); else r.append(0.0);
     }
@@ -669,39 +794,6 @@ QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& p
     return r;
 }
 
-QVector<QVector<double>> FittingWidget::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) {
-    int nRes = baseResiduals.size(); int nParams = fitIndices.size();
-    QVector<QVector<double>> J(nRes, QVector<double>(nParams));
-    for(int j = 0; j < nParams; ++j) {
-        int idx = fitIndices[j]; QString pName = currentFitParams[idx].name;
-        double val = params.value(pName); bool isLog = (val > 1e-12 && pName != "S" && pName != "nf");
-        double h; QMap<QString, double> pPlus = params; QMap<QString, double> pMinus = params;
-        if(isLog) { h = 0.01; double valLog = log10(val); pPlus[pName] = pow(10.0, valLog + h); pMinus[pName] = pow(10.0, valLog - h); }
-        else { h = 1e-4; pPlus[pName] = val + h; pMinus[pName] = val - h; }
-        auto updateDeps = [](QMap<QString,double>& map) { if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9) map["LfD"] = map["Lf"] / map["L"]; };
-        if(pName == "L" || pName == "Lf") { updateDeps(pPlus); updateDeps(pMinus); }
-        QVector<double> rPlus = calculateResiduals(pPlus, modelType, weight);
-        QVector<double> rMinus = calculateResiduals(pMinus, modelType, weight);
-        if(rPlus.size() == nRes && rMinus.size() == nRes) {
-            for(int i=0; i<nRes; ++i) J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * h);
-        }
-    }
-    return J;
-}
-
-QVector<double> FittingWidget::solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b) {
-    int n = b.size(); if (n == 0) return QVector<double>();
-    Eigen::MatrixXd matA(n, n); Eigen::VectorXd vecB(n);
-    for (int i = 0; i < n; ++i) { vecB(i) = b[i]; for (int j = 0; j < n; ++j) matA(i, j) = A[i][j]; }
-    Eigen::VectorXd x = matA.ldlt().solve(vecB);
-    QVector<double> res(n); for (int i = 0; i < n; ++i) res[i] = x(i);
-    return res;
-}
-
-double FittingWidget::calculateSumSquaredError(const QVector<double>& residuals) {
-    double sse = 0.0; for(double v : residuals) sse += v*v; return sse;
-}
-
 void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
                                       const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve) {
     ui->label_Error->setText(QString("误差(MSE): %1").arg(err, 0, 'e', 3));
@@ -719,7 +811,7 @@ void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
     plotCurves(t, p_curve, d_curve, true);
 }
 
-void FittingWidget::onFitFinished() { m_isFitting = false; ui->btnRunFit->setEnabled(true); QMessageBox::information(this, "完成", "拟合完成。"); }
+void FittingWidget::onFitFinished() { m_isFitting = false; ui->btnRunFit->setEnabled(true); ui->comboFitMethod->setEnabled(true); QMessageBox::information(this, "完成", "拟合完成。"); }
 
 void FittingWidget::plotCurves(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d, bool isModel) {
     QVector<double> vt, vp, vd;
@@ -16,7 +16,11 @@
 #include <QVector>
 #include <QFutureWatcher>
 #include <QJsonObject>
+#include <atomic>
 #include "modelmanager.h"
+#include "levenbergmarquardt.h"
+#include "multistartsearch.h"
+#include "differentialevolution.h"
 #include "mousezoom.h"
 #include "chartsetting1.h"
 
@@ -27,6 +31,39 @@
 
 namespace Ui { class FittingWidget; }
 
+// 拟合方法 (取值与界面下拉框的序号一致)
+enum class FitMethod {
+    LevenbergMarquardt,   // 从参数表当前值出发的局部 LM
+    MultiStart,           // 拉丁超立方多起点短 LM 并发搜索后精细化最优若干个
+    DifferentialEvolution // 自适应差分进化，每代种群并发求值
+};
+
+// 参与拟合的参数与求解变量之间的映射: 正值参数 (S、nf 除外) 在 log10 空间中求解，边界与差分步长随之变换
+struct FitVariables {
+    QMap<QString, double> paramMap;  // 完整参数表 (含由 L / Lf 换算的 LfD)
+    CompositeModelParameters base;   // paramMap 的结构体形式
+    QVector<QString> names;          // 求解变量对应的参数名 (只含模型使用的参数)
+    QVector<char> isLog;             // 是否在 log10 空间中求解
+    QVector<double> x;               // 初始值
+    QVector<double> lower;           // 下界 (log 变量下界不为正时为 -inf)
+    QVector<double> upper;           // 上界
+    QVector<double> steps;           // 差分步长
+
+    static FitVariables fromParameters(const QList<FitParameter>& params);
+    // 求解变量 → 参数 (L / Lf 的变化由 setValue 同步更新 LfD)
+    CompositeModelParameters toParams(const QVector<double>& v) const;
+    QMap<QString, double> toParamMap(const QVector<double>& v) const;
+};
+
+// 拟合开始时复制的方法、产量历史与各优化器配置: 工作线程只读这份快照，界面线程随后的修改只对下一次拟合生效
+struct FitSettings {
+    FitMethod method;
+    RateHistory rateHistory;
+    LevenbergMarquardtConfig solverConfig;
+    MultiStartConfig multiStartConfig;
+    DifferentialEvolutionConfig evolutionConfig;
+};
+
 class FittingWidget : public QWidget
 {
     Q_OBJECT
@@ -41,6 +78,26 @@ public:
     // 设置观测数据（时间、压力、导数）
     void setObservedData(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d);
 
+    // 设置产量历史（多段时理论曲线与残差按变产量叠加计算；由 FittingPage 以图表页的时长-产量表构造后传入）
+    void setRateHistory(const RateHistory& history);
+
+    // 设置 LM 求解器配置 (收敛判据、阻尼、边界处理、测地线加速等)
+    // 以下配置均在拟合开始时复制进 FitSettings，拟合进行中修改只对下一次拟合生效
+    void setSolverConfig(const LevenbergMarquardtConfig& config) { m_solverConfig = config; }
+    LevenbergMarquardtConfig solverConfig() const { return m_solverConfig; }
+
+    // 设置雅可比策略 (Broyden 时 refreshInterval 为两次差分之间的最大割线更新次数)
+    void setJacobianStrategy(JacobianStrategy strategy, int refreshInterval = 5);
+
+    // 设置拟合方法与多起点搜索、差分进化配置 (界面下拉框同步切换)
+    void setFitMethod(FitMethod method);
+    FitMethod fitMethod() const { return m_fitMethod; }
+    void setMultiStartConfig(const MultiStartConfig& config) { m_multiStartConfig = config; }
+    void setEvolutionConfig(const DifferentialEvolutionConfig& config) { m_evolutionConfig = config; }
+
+    // 最近一次拟合的收敛统计 (拟合结束后在界面线程更新，拟合进行中仍为上一次的结果)
+    FitStatistics lastFitStatistics() const { return m_lastFitStatistics; }
+
     // 基础参数更新接口（供外部调用）
     void updateBasicParameters();
 
@@ -81,6 +138,7 @@ private slots:
     void onIterationUpdate(double err, const QMap<QString,double>& p, const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve);
     void onFitFinished();
     void onSliderWeightChanged(int value); // 权重滑块改变
+    void onFitMethodChanged(int index);    // 拟合方法下拉框改变
 
 private:
     Ui::FittingWidget *ui;
@@ -98,9 +156,19 @@ private:
     QVector<double> m_obsPressure;
     QVector<double> m_obsDerivative;
 
+    // 产量历史 (为空或只有一段时为恒定产量)
+    RateHistory m_rateHistory;
+
+    // 拟合方法、各优化器配置，以及最近一次拟合统计
+    FitMethod m_fitMethod;
+    LevenbergMarquardtConfig m_solverConfig;
+    MultiStartConfig m_multiStartConfig;
+    DifferentialEvolutionConfig m_evolutionConfig;
+    FitStatistics m_lastFitStatistics;
+
     // 拟合控制标志
     bool m_isFitting;
-    bool m_stopRequested;
+    std::atomic<bool> m_stopRequested; // 界面线程写入，拟合工作线程读取
     QFutureWatcher<void> m_watcher;
 
     // 初始化绘图控件配置
@@ -110,18 +178,28 @@ private:
     // 根据当前参数更新理论曲线
     void updateModelCurve();
 
-    // 优化算法相关函数 (Levenberg-Marquardt)
-    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight);
-    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight);
-
-    // 计算残差
-    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight);
-    // 计算雅可比矩阵
-    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& residuals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight);
-    // 求解线性方程组 (Eigen)
-    QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
-    // 计算平方误差和
-    double calculateSumSquaredError(const QVector<double>& residuals);
+    // 优化算法相关函数 (按 settings.method 分派，在工作线程中运行)
+    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight, const FitSettings& settings);
+    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings);
+    void runMultiStartOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings);
+    void runDifferentialEvolutionOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight, const FitSettings& settings);
+    // 拟合结束: 输出统计、以高精度重算最终曲线，并把统计与结束通知一并交给界面线程
+    void finishOptimization(ModelManager::ModelType modelType, const QMap<QString, double>& params, const RateHistory& history,
+                            const FitStatistics& stats, const char* label);
+
+    // 计算理论曲线 (history 为多段产量时为叠加曲线；界面线程传 m_rateHistory，工作线程传 FitSettings 中的快照)
+    ModelCurveData calculateModelCurve(ModelManager::ModelType modelType, const QMap<QString, double>& params, const RateHistory& history,
+                                       const QVector<double>& time, const ModelEvaluationConfig& config = ModelEvaluationConfig()) const;
+
+    // 拟合期间 (残差与迭代过程中的曲线刷新) 统一使用的求值配置
+    static ModelEvaluationConfig fitEvaluationConfig(bool parallelModel = true);
+
+    // 计算残差 (参数表在此一次性转换为 CompositeModelParameters)
+    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight,
+                                       const RateHistory& history);
+    // parallelModel 为 false 时单条曲线内部不再分发线程池 (调用方已在外层并发时使用，线程安全)
+    QVector<double> calculateResiduals(const CompositeModelParameters& params, ModelManager::ModelType modelType, double weight,
+                                       const RateHistory& history, bool parallelModel = true);
 
     // 获取图表 Base64 字符串用于报告
     QString getPlotImageBase64();
@@ -158,6 +158,32 @@ WT_PlottingWidget::~WT_PlottingWidget()
 void WT_PlottingWidget::setDataModel(QStandardItemModel* model) { m_dataModel = model; }
 void WT_PlottingWidget::setProjectPath(const QString& path) { m_projectPath = path; }
 
+bool WT_PlottingWidget::getRateTable(QVector<double>& durations, QVector<double>& rates) const
+{
+    durations.clear(); rates.clear();
+
+    // 阶梯图的 x2Data 为各段时长 (与 PlottingStackWidget 相同)；散点、折线图的 x2Data 为时间点，不作为产量历史
+    auto isRateTable = [](const CurveInfo& info) { return info.type == 1 && info.prodGraphType == 0; };
+    const CurveInfo* source = nullptr;
+    auto current = m_curves.constFind(m_currentDisplayedCurve);
+    if (current != m_curves.constEnd() && isRateTable(current.value())) {
+        source = &current.value();
+    } else {
+        for (auto it = m_curves.constBegin(); it != m_curves.constEnd(); ++it) {
+            if (isRateTable(it.value())) { source = &it.value(); break; }
+        }
+    }
+    if (!source) return false;
+
+    int count = qMin(source->x2Data.size(), source->y2Data.size());
+    for (int i = 0; i < count; ++i) {
+        if (source->x2Data[i] <= 0) continue;
+        durations.append(source->x2Data[i]);
+        rates.append(source->y2Data[i]);
+    }
+    return !durations.isEmpty();
+}
+
 // [新增] 加载项目数据
 void WT_PlottingWidget::loadProjectData()
 {
@@ -70,6 +70,10 @@ public:
     // 应在 MainWindow 打开项目后调用此函数
     void loadProjectData();
 
+    // 取压力产量图 (阶梯图) 的时长-产量表，优先当前显示的曲线；没有阶梯产量数据时返回 false
+    // 时长不大于 0 的行 (空单元格) 被跳过，供拟合页以 RateHistory::fromDurations 构造产量历史
+    bool getRateTable(QVector<double>& durations, QVector<double>& rates) const;
+
 private slots:
     void on_btn_NewCurve_clicked();
     void on_btn_PressureRate_clicked();